@@ -18,39 +18,74 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 #include <stdio.h>
+#include <string.h>
 #include "pico/stdlib.h"
 #include "hardware/gpio.h"
 #include "pico/binary_info.h"
 #include "hardware/i2c.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/pio.h"
+#include "hardware/clocks.h"
+#include "hardware/structs/sio.h"
 
 #include "BitBang_I2C.h"
+#include "i2c_master.pio.h"
 
-static uint8_t SDA_READ(uint8_t iSDA)
+//
+// Software backend (I2C_BACKEND_BITBANG)
+// Open-drain emulation straight on the SIO registers: the output latch of
+// both pins stays 0, a line is pulled low by enabling its output driver and
+// released to the pull-up by disabling it. iDelay holds the clk_sys cycles to
+// wait in each half of the SCL period, worked out in I2CInit().
+// The byte loops run from SRAM so flash (XIP cache misses) can't stretch a
+// bit, and a slave holding SCL low is waited for up to I2C_BB_STRETCH_US.
+//
+#define I2C_BB_OVERHEAD   12    // cycles per half period spent outside the delay
+#define I2C_BB_STRETCH_US 10000 // longest clock stretch before giving up
+
+static volatile uint8_t bStretchTimeout; // a slave held SCL low for too long
+
+static __force_inline uint32_t SDA_READ(uint32_t u32SDA)
 {
-    return gpio_get(iSDA);
+    return sio_hw->gpio_in & u32SDA;
 }
-static void SCL_HIGH(uint8_t iSCL)
+
+static __force_inline void SDA_HIGH(uint32_t u32SDA)
 {
-    gpio_init(iSCL);
-    gpio_set_dir(iSCL, GPIO_IN);
+    sio_hw->gpio_oe_clr = u32SDA;
 }
 
-static void SCL_LOW(uint8_t iSCL)
+static __force_inline void SDA_LOW(uint32_t u32SDA)
 {
-    gpio_set_dir(iSCL, GPIO_OUT);
-    gpio_put(iSCL, LOW);
+    sio_hw->gpio_oe_set = u32SDA;
 }
 
-static void SDA_HIGH(uint8_t iSDA)
+static __force_inline void SCL_LOW(uint32_t u32SCL)
 {
-    gpio_init(iSDA);
-    gpio_set_dir(iSDA, GPIO_IN);
+    sio_hw->gpio_oe_set = u32SCL;
 }
 
-static void SDA_LOW(uint8_t iSDA)
+// release SCL and wait for it to read high, a slave may hold it low
+// (clock stretching), returns 0 if it never let go
+static __force_inline int SCL_HIGH(uint32_t u32SCL)
 {
-    gpio_set_dir(iSDA, GPIO_OUT);
-    gpio_put(iSDA, LOW);
+uint32_t u32Start;
+
+    sio_hw->gpio_oe_clr = u32SCL;
+    if (sio_hw->gpio_in & u32SCL)
+        return 1;
+    u32Start = time_us_32(); // usually just the rise time of the pull-up
+    while (!(sio_hw->gpio_in & u32SCL))
+    {
+        if (time_us_32() - u32Start > I2C_BB_STRETCH_US)
+        {
+            bStretchTimeout = 1;
+            return 0;
+        }
+    }
+    return 1;
 }
 
 //
@@ -59,95 +94,78 @@ static void SDA_LOW(uint8_t iSDA)
 // otherwise return 1 for success
 //
 
-static int i2cByteOut(BBI2C *pI2C, uint8_t b)
+static int __not_in_flash_func(i2cByteOut)(BBI2C *pI2C, uint8_t b)
 {
-uint8_t i, ack;
-uint8_t iSDA = pI2C->iSDA;
-uint8_t iSCL = pI2C->iSCL; // in case of bad C compiler
-int iDelay = pI2C->iDelay;
+uint8_t i;
+uint32_t ack;
+uint32_t u32SDA = 1u << pI2C->iSDA;
+uint32_t u32SCL = 1u << pI2C->iSCL;
+uint32_t iDelay = pI2C->iDelay;
 
+// SCL is low here. SDA changes right after the clock falls and has the
+// low half of the bit to settle before the clock rises again (data setup)
   for (i=0; i<8; i++)
   {
       if (b & 0x80)
-        SDA_HIGH(iSDA); // set data line to 1
+        SDA_HIGH(u32SDA); // set data line to 1
       else
-        SDA_LOW(iSDA); // set data line to 0
-      SCL_HIGH(iSCL); // clock high (slave latches data)
-      sleep_us(iDelay);
-      SCL_LOW(iSCL); // clock low
+        SDA_LOW(u32SDA); // set data line to 0
       b <<= 1;
-      sleep_us(iDelay);
+      busy_wait_at_least_cycles(iDelay);
+      if (!SCL_HIGH(u32SCL)) // clock high (slave latches data)
+        return 0;
+      busy_wait_at_least_cycles(iDelay);
+      SCL_LOW(u32SCL); // clock low
   } // for i
 // read ack bit
-  SDA_HIGH(iSDA); // set data line for reading
-  SCL_HIGH(iSCL); // clock line high
-  sleep_us(iDelay); // DEBUG - delay/2
-  ack = SDA_READ(iSDA);
-  SCL_LOW(iSCL); // clock low
-  sleep_us(iDelay); // DEBUG - delay/2
-  SDA_LOW(iSDA); // data low
+  SDA_HIGH(u32SDA); // set data line for reading
+  busy_wait_at_least_cycles(iDelay);
+  if (!SCL_HIGH(u32SCL)) // clock line high
+    return 0;
+  busy_wait_at_least_cycles(iDelay);
+  ack = SDA_READ(u32SDA);
+  SCL_LOW(u32SCL); // clock low
+  SDA_LOW(u32SDA); // data low
+  busy_wait_at_least_cycles(iDelay);
   return (ack == 0) ? 1:0; // a low ACK bit means success
 } /* i2cByteOut() */
 
-static int i2cByteOutFast(BBI2C *pI2C, uint8_t b)
-{
-uint8_t i, ack, iSDA, iSCL;
-int iDelay;
-
-     iSDA = pI2C->iSDA;
-     iSCL = pI2C->iSCL;
-     iDelay = pI2C->iDelay;
-
-     if (b & 0x80)
-        SDA_HIGH(iSDA); // set data line to 1
-     else
-        SDA_LOW(iSDA); // set data line to 0
-     for (i=0; i<8; i++)
-     {
-         SCL_HIGH(iSCL); // clock high (slave latches data)
-         sleep_us(iDelay);
-         SCL_LOW(iSCL); // clock low
-         sleep_us(iDelay);
-     } // for i
-// read ack bit
-  SDA_HIGH(iSDA); // set data line for reading
-  SCL_HIGH(iSCL); // clock line high
-  sleep_us(pI2C->iDelay); // DEBUG - delay/2
-  ack = SDA_READ(iSDA);
-  SCL_LOW(iSCL); // clock low
-  sleep_us(pI2C->iDelay); // DEBUG - delay/2
-  SDA_LOW(iSDA); // data low
-  return (ack == 0) ? 1:0; // a low ACK bit means success
-} /* i2cByteOutFast() */
 //
 // Receive a byte and read the ack bit
 // if we get a NACK (negative acknowledge) return 0
 // otherwise return 1 for success
 //
-static uint8_t i2cByteIn(BBI2C *pI2C, uint8_t bLast)
+static uint8_t __not_in_flash_func(i2cByteIn)(BBI2C *pI2C, uint8_t bLast)
 {
 uint8_t i;
 uint8_t b = 0;
+uint32_t u32SDA = 1u << pI2C->iSDA;
+uint32_t u32SCL = 1u << pI2C->iSCL;
+uint32_t iDelay = pI2C->iDelay;
 
-     SDA_HIGH(pI2C->iSDA); // set data line as input
+     SDA_HIGH(u32SDA); // set data line as input
      for (i=0; i<8; i++)
      {
-         sleep_us(pI2C->iDelay); // wait for data to settle
-         SCL_HIGH(pI2C->iSCL); // clock high (slave latches data)
+         busy_wait_at_least_cycles(iDelay); // wait for data to settle
+         if (!SCL_HIGH(u32SCL)) // clock high (slave latches data)
+           return 0xff;
+         busy_wait_at_least_cycles(iDelay);
          b <<= 1;
-         if (SDA_READ(pI2C->iSDA) != 0) // read the data bit
+         if (SDA_READ(u32SDA) != 0) // read the data bit
            b |= 1; // set data bit
-         SCL_LOW(pI2C->iSCL); // cloc low
+         SCL_LOW(u32SCL); // clock low
      } // for i
      if (bLast)
-        SDA_HIGH(pI2C->iSDA); // last byte sends a NACK
+        SDA_HIGH(u32SDA); // last byte sends a NACK
      else
-        SDA_LOW(pI2C->iSDA);
-     SCL_HIGH(pI2C->iSCL); // clock high
-     sleep_us(pI2C->iDelay);
-     SCL_LOW(pI2C->iSCL); // clock low to send ack
-     sleep_us(pI2C->iDelay);
-     SDA_LOW(pI2C->iSDA); // data low
+        SDA_LOW(u32SDA);
+     busy_wait_at_least_cycles(iDelay);
+     if (!SCL_HIGH(u32SCL)) // clock high
+        return 0xff;
+     busy_wait_at_least_cycles(iDelay);
+     SCL_LOW(u32SCL); // clock low to send ack
+     SDA_LOW(u32SDA); // data low
+     busy_wait_at_least_cycles(iDelay);
   return b;
 } /* i2cByteIn() */
 
@@ -156,21 +174,24 @@ uint8_t b = 0;
 //
 static void i2cEnd(BBI2C *pI2C)
 {
-   SDA_LOW(pI2C->iSDA); // data line low
-   sleep_us(pI2C->iDelay);
-   SCL_HIGH(pI2C->iSCL); // clock high
-   sleep_us(pI2C->iDelay);
-   SDA_HIGH(pI2C->iSDA); // data high
-   sleep_us(pI2C->iDelay);
+uint32_t u32SDA = 1u << pI2C->iSDA;
+
+   SDA_LOW(u32SDA); // data line low
+   busy_wait_at_least_cycles(pI2C->iDelay);
+   SCL_HIGH(1u << pI2C->iSCL); // clock high
+   busy_wait_at_least_cycles(pI2C->iDelay);
+   SDA_HIGH(u32SDA); // data high
+   busy_wait_at_least_cycles(pI2C->iDelay);
 } /* i2cEnd() */
 
 
 static int i2cBegin(BBI2C *pI2C, uint8_t addr, uint8_t bRead)
 {
    int rc;
-   SDA_LOW(pI2C->iSDA); // data line low first
-   sleep_us(pI2C->iDelay);
-   SCL_LOW(pI2C->iSCL); // then clock line low is a START signal
+   bStretchTimeout = 0;
+   SDA_LOW(1u << pI2C->iSDA); // data line low first
+   busy_wait_at_least_cycles(pI2C->iDelay);
+   SCL_LOW(1u << pI2C->iSCL); // then clock line low is a START signal
    addr <<= 1;
    if (bRead)
       addr++; // set read bit
@@ -178,35 +199,474 @@ static int i2cBegin(BBI2C *pI2C, uint8_t addr, uint8_t bRead)
    return rc;
 } /* i2cBegin() */
 
-static int i2cWrite(BBI2C *pI2C, uint8_t *pData, int iLen)
+//
+// Frames are sent from here, so the source is read a word at a time once it
+// is aligned: one load per four bytes, shifted out LSB (first byte) first.
+//
+static int __not_in_flash_func(i2cWrite)(BBI2C *pI2C, uint8_t *pData, int iLen)
 {
-uint8_t b;
-int rc, iOldLen = iLen;
+uint32_t u32, *pWords;
+int i, iOldLen = iLen;
 
-   rc = 1;
-   while (iLen && rc == 1)
+   while (iLen && ((uintptr_t)pData & 3)) // up to a word boundary
    {
-      b = *pData++;
-//      if (b == 0xff || b == 0)
-//         rc = i2cByteOutFast(pI2C, b); // speed it up a bit more if all bits are ==
-//      else
-         rc = i2cByteOut(pI2C, b);
-      if (rc == 1) // success
+      if (!i2cByteOut(pI2C, *pData++))
+         return 0; // bad ack from sending a byte
+      iLen--;
+   }
+   pWords = (uint32_t *)pData;
+   while (iLen >= 4)
+   {
+      u32 = *pWords++;
+      for (i=0; i<4; i++)
       {
-         iLen--;
+         if (!i2cByteOut(pI2C, (uint8_t)u32))
+            return 0;
+         u32 >>= 8;
       }
-   } // for each byte
-   return (rc == 1) ? (iOldLen - iLen) : 0; // 0 indicates bad ack from sending a byte
+      iLen -= 4;
+   }
+   pData = (uint8_t *)pWords;
+   while (iLen) // leftover bytes
+   {
+      if (!i2cByteOut(pI2C, *pData++))
+         return 0;
+      iLen--;
+   }
+   return iOldLen;
 } /* i2cWrite() */
 
 static void i2cRead(BBI2C *pI2C, uint8_t *pData, int iLen)
 {
-   while (iLen--)
+   while (iLen-- && !bStretchTimeout)
    {
       *pData++ = i2cByteIn(pI2C, iLen == 0);
    } // for each byte
 } /* i2cRead() */
 //
+// DMA fed backends (I2C_BACKEND_HW_DMA and I2C_BACKEND_PIO_DMA)
+// Writes are turned into 16-bit FIFO words in a ring buffer and a DMA
+// channel paced by the TX DREQ drains it, so the caller only waits when the
+// ring is full. The DMA interrupt restarts the channel on whatever was queued
+// while it was busy.
+// HW_DMA:  IC_DATA_CMD words for the I2C block, STOP set on the last byte
+// PIO_DMA: records for the i2c_master PIO program (i2c_master.pio), with the
+//          START/STOP sequences queued as instruction records
+//
+#define I2C_DMA_RING 2048 // 16-bit FIFO words, a few full frames
+#define I2C_WIRE_CHUNK 128 // longest I2CWriteQueued transfer on the blocking backend
+
+// i2c_master record fields
+#define PIO_I2C_ICOUNT_LSB 10
+#define PIO_I2C_FINAL_LSB  9
+#define PIO_I2C_DATA_LSB   1
+#define PIO_I2C_NAK_LSB    0
+
+static uint16_t u16DmaRing[I2C_DMA_RING];
+static volatile uint32_t u32DmaHead, u32DmaTail; // free running, index with % I2C_DMA_RING
+static volatile uint32_t u32DmaCount;             // entries the channel is moving now
+static int iDmaChan = -1;
+static uint8_t u8DmaBackend;     // backend that owns the ring
+static i2c_inst_t *pDmaI2C;      // HW_DMA
+static PIO pDmaPIO = pio1;       // PIO_DMA, pio0 drives the NeoPixels
+static int iDmaSM = -1;
+static uint iPioOffset;
+static uint8_t u8DmaAddr = 0xff; // current target address (HW_DMA)
+static volatile uint8_t bDmaAbort; // a queued write was NACKed
+
+// completion callbacks, each fires once the ring tail passes u32End
+#define I2C_DONE_QUEUE 16
+static struct {
+   uint32_t u32End;
+   I2CCALLBACK pfnDone;
+   void *pUser;
+} doneQueue[I2C_DONE_QUEUE];
+static volatile uint32_t u32DoneHead, u32DoneTail; // free running
+
+// hardware block wired to a pin pair, GPIO 0/1 -> I2C0, 2/3 -> I2C1, ...
+static i2c_inst_t *i2cHW(BBI2C *pI2C)
+{
+   if (pI2C->bWire == I2C_BACKEND_HW_DMA)
+      return ((pI2C->iSDA >> 1) & 1) ? i2c1 : i2c0;
+   return i2c0;
+} /* i2cHW() */
+
+// start the channel on the next contiguous piece of the ring, call with
+// the DMA IRQ masked or from the handler
+static void i2cDmaKick(void)
+{
+uint32_t iStart, iCount;
+
+   if (u32DmaCount || u32DmaHead == u32DmaTail)
+      return;
+   iStart = u32DmaTail % I2C_DMA_RING;
+   iCount = u32DmaHead - u32DmaTail;
+   if (iStart + iCount > I2C_DMA_RING) // wraps, send up to the end first
+      iCount = I2C_DMA_RING - iStart;
+   u32DmaCount = iCount;
+   dma_channel_transfer_from_buffer_now(iDmaChan, &u16DmaRing[iStart], iCount);
+} /* i2cDmaKick() */
+
+// run the callbacks of everything the DMA has handed over, or of everything
+// still queued with bOK = 0 when the ring was dropped
+static void i2cDmaDone(int bOK)
+{
+uint32_t i;
+
+   while (u32DoneTail != u32DoneHead)
+   {
+      i = u32DoneTail % I2C_DONE_QUEUE;
+      if (bOK && (int32_t)(u32DmaTail - doneQueue[i].u32End) < 0)
+         break;
+      u32DoneTail++;
+      (*doneQueue[i].pfnDone)(doneQueue[i].pUser, bOK);
+   }
+} /* i2cDmaDone() */
+
+static void i2cDmaIRQ(void)
+{
+   if (!dma_channel_get_irq1_status(iDmaChan))
+      return; // shared handler, not ours
+   dma_channel_acknowledge_irq1(iDmaChan);
+   u32DmaTail += u32DmaCount;
+   u32DmaCount = 0;
+   i2cDmaKick();
+   i2cDmaDone(1);
+} /* i2cDmaIRQ() */
+
+static void i2cDmaCheckAbort(void);
+
+// add a callback at ring position u32End, call with the DMA IRQ masked
+static void i2cDmaAddDone(uint32_t u32End, I2CCALLBACK pfnDone, void *pUser)
+{
+uint32_t i;
+
+   while (u32DoneHead - u32DoneTail >= I2C_DONE_QUEUE) // full, wait for the oldest
+   {
+      irq_set_enabled(DMA_IRQ_1, true);
+      i2cDmaCheckAbort();
+      tight_loop_contents();
+      irq_set_enabled(DMA_IRQ_1, false);
+   }
+   i = u32DoneHead % I2C_DONE_QUEUE;
+   doneQueue[i].u32End = u32End;
+   doneQueue[i].pfnDone = pfnDone;
+   doneQueue[i].pUser = pUser;
+   u32DoneHead++;
+} /* i2cDmaAddDone() */
+
+// write one record straight into the PIO FIFO, only used while the DMA is idle
+static void i2cPioPut16(uint16_t u16)
+{
+   while (pio_sm_is_tx_fifo_full(pDmaPIO, iDmaSM))
+   {
+      if (pio_interrupt_get(pDmaPIO, iDmaSM))
+         return; // stalled on a NACK, the caller recovers
+   }
+   *(io_rw_16 *)&pDmaPIO->txf[iDmaSM] = u16;
+} /* i2cPioPut16() */
+
+static void i2cPioStop(void)
+{
+   i2cPioPut16(2u << PIO_I2C_ICOUNT_LSB);
+   i2cPioPut16(set_scl_sda_program_instructions[I2C_SC0_SD0]); // SDA is unknown; pull it down
+   i2cPioPut16(set_scl_sda_program_instructions[I2C_SC1_SD0]); // release clock
+   i2cPioPut16(set_scl_sda_program_instructions[I2C_SC1_SD1]); // release SDA to return to idle state
+} /* i2cPioStop() */
+
+//
+// Collect a NACK from the bus. The I2C block flushes its FIFO on an abort,
+// the PIO program halts on an IRQ flag; either way whatever is still queued
+// belongs to a failed transfer, so it is dropped and the bus set idle again.
+//
+static void i2cDmaCheckAbort(void)
+{
+i2c_hw_t *hw;
+int bAbort;
+
+   if (u8DmaBackend == I2C_BACKEND_HW_DMA)
+   {
+      hw = i2c_get_hw(pDmaI2C);
+      bAbort = (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) != 0;
+   }
+   else
+      bAbort = pio_interrupt_get(pDmaPIO, iDmaSM);
+   if (!bAbort)
+      return;
+
+   irq_set_enabled(DMA_IRQ_1, false);
+   dma_channel_set_irq1_enabled(iDmaChan, false);
+   dma_channel_abort(iDmaChan);
+   dma_channel_acknowledge_irq1(iDmaChan);
+   dma_channel_set_irq1_enabled(iDmaChan, true);
+   u32DmaTail = u32DmaHead;
+   u32DmaCount = 0;
+   if (u8DmaBackend == I2C_BACKEND_HW_DMA)
+   {
+      (void)hw->clr_tx_abrt;
+   }
+   else
+   {
+      pio_sm_drain_tx_fifo(pDmaPIO, iDmaSM);
+      // jump back to the wrap target (entry_point), a JMP is just the address
+      pio_sm_exec(pDmaPIO, iDmaSM, (pDmaPIO->sm[iDmaSM].execctrl & PIO_SM0_EXECCTRL_WRAP_BOTTOM_BITS) >> PIO_SM0_EXECCTRL_WRAP_BOTTOM_LSB);
+      pio_interrupt_clear(pDmaPIO, iDmaSM);
+      i2cPioStop();
+   }
+   bDmaAbort = 1;
+   i2cDmaDone(0);
+   irq_set_enabled(DMA_IRQ_1, true);
+} /* i2cDmaCheckAbort() */
+
+static void i2cDmaInit(BBI2C *pI2C, uint32_t iClock)
+{
+dma_channel_config c;
+volatile void *pFIFO;
+uint iDREQ;
+
+   u8DmaBackend = pI2C->bWire;
+   if (u8DmaBackend == I2C_BACKEND_HW_DMA)
+   {
+      pDmaI2C = i2cHW(pI2C);
+      i2c_init(pDmaI2C, iClock);
+      gpio_set_function(pI2C->iSDA, GPIO_FUNC_I2C);
+      gpio_set_function(pI2C->iSCL, GPIO_FUNC_I2C);
+      gpio_pull_up(pI2C->iSDA);
+      gpio_pull_up(pI2C->iSCL);
+      pFIFO = &i2c_get_hw(pDmaI2C)->data_cmd;
+      iDREQ = i2c_get_dreq(pDmaI2C, true);
+   }
+   else
+   {
+      if (iDmaSM < 0)
+      {
+         iPioOffset = pio_add_program(pDmaPIO, &i2c_master_program);
+         iDmaSM = pio_claim_unused_sm(pDmaPIO, true);
+      }
+      i2c_master_program_init(pDmaPIO, iDmaSM, iPioOffset, pI2C->iSDA, pI2C->iSCL, iClock);
+      // writes only, don't let the sampled bits fill the RX FIFO and stall
+      hw_clear_bits(&pDmaPIO->sm[iDmaSM].shiftctrl, PIO_SM0_SHIFTCTRL_AUTOPUSH_BITS);
+      pFIFO = &pDmaPIO->txf[iDmaSM];
+      iDREQ = pio_get_dreq(pDmaPIO, iDmaSM, true);
+   }
+   u8DmaAddr = 0xff;
+   u32DmaHead = u32DmaTail = u32DmaCount = 0;
+   u32DoneHead = u32DoneTail = 0;
+   bDmaAbort = 0;
+   if (iDmaChan < 0)
+   {
+      iDmaChan = dma_claim_unused_channel(true);
+      irq_add_shared_handler(DMA_IRQ_1, i2cDmaIRQ, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+      irq_set_enabled(DMA_IRQ_1, true);
+   }
+   c = dma_channel_get_default_config(iDmaChan);
+   channel_config_set_transfer_data_size(&c, DMA_SIZE_16); // halfword writes, the PIO OSR takes the top 16 bits
+   channel_config_set_read_increment(&c, true);
+   channel_config_set_write_increment(&c, false);
+   channel_config_set_dreq(&c, iDREQ);
+   dma_channel_configure(iDmaChan, &c, pFIFO, u16DmaRing, 0, false);
+   dma_channel_set_irq1_enabled(iDmaChan, true);
+} /* i2cDmaInit() */
+
+int I2CWait(BBI2C *pI2C)
+{
+i2c_hw_t *hw;
+int rc;
+
+   if ((pI2C->bWire != I2C_BACKEND_HW_DMA && pI2C->bWire != I2C_BACKEND_PIO_DMA) || iDmaChan < 0)
+      return 1; // the other backends are synchronous
+   while (u32DmaHead != u32DmaTail)
+   {
+      i2cDmaCheckAbort(); // a halted bus never drains
+      tight_loop_contents();
+   }
+   if (u8DmaBackend == I2C_BACKEND_HW_DMA)
+   {
+      // ring is empty, wait for the FIFO and the last STOP
+      hw = i2c_get_hw(pDmaI2C);
+      while (!(hw->status & I2C_IC_STATUS_TFE_BITS) || (hw->status & I2C_IC_STATUS_ACTIVITY_BITS))
+      {
+         if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS)
+            break;
+         tight_loop_contents();
+      }
+   }
+   else
+   {
+      // done when the state machine stalls on an empty FIFO or halts on a NACK
+      pDmaPIO->fdebug = 1u << (PIO_FDEBUG_TXSTALL_LSB + iDmaSM);
+      while (!(pDmaPIO->fdebug & (1u << (PIO_FDEBUG_TXSTALL_LSB + iDmaSM))) && !pio_interrupt_get(pDmaPIO, iDmaSM))
+         tight_loop_contents();
+   }
+   i2cDmaCheckAbort();
+   rc = !bDmaAbort;
+   bDmaAbort = 0;
+   return rc;
+} /* I2CWait() */
+
+// add one word to the ring, returns 0 if a NACK cancelled the transfer
+// while waiting for room
+static int i2cDmaPut(uint32_t *pHead, uint16_t u16)
+{
+   while (*pHead - u32DmaTail >= I2C_DMA_RING) // ring full, let the DMA catch up
+   {
+      irq_set_enabled(DMA_IRQ_1, false);
+      u32DmaHead = *pHead; // publish what we have so far
+      i2cDmaKick();
+      irq_set_enabled(DMA_IRQ_1, true);
+      i2cDmaCheckAbort();
+      if (bDmaAbort)
+         return 0; // the ring was dropped, this transfer with it
+   }
+   u16DmaRing[*pHead % I2C_DMA_RING] = u16;
+   (*pHead)++;
+   return 1;
+} /* i2cDmaPut() */
+
+//
+// Expand a write into FIFO words at the ring head. iControl >= 0 goes out
+// ahead of pData (the command/data byte of a display controller), pfnDone
+// is queued to run once the last word has gone to the controller.
+//
+static int i2cDmaWrite(BBI2C *pI2C, uint8_t iAddr, int iControl, uint8_t *pData, int iLen, I2CCALLBACK pfnDone, void *pUser)
+{
+i2c_hw_t *hw;
+uint32_t u32Head;
+uint16_t u16;
+int i, rc, bFinal, iTotal;
+uint8_t b;
+
+   iTotal = iLen + (iControl >= 0);
+   if (iLen < 0 || iTotal == 0)
+      return 0;
+   if (u8DmaBackend == I2C_BACKEND_HW_DMA && iAddr != u8DmaAddr) // TAR can only change while the block is idle
+   {
+      if (!I2CWait(pI2C))
+         bDmaAbort = 1; // keep it for the return value below
+      hw = i2c_get_hw(pDmaI2C);
+      hw->enable = 0;
+      hw->tar = iAddr;
+      hw->enable = 1;
+      u8DmaAddr = iAddr;
+   }
+   i2cDmaCheckAbort();
+   rc = bDmaAbort ? 0 : iTotal; // report a NACK of an earlier write
+   bDmaAbort = 0;
+
+   u32Head = u32DmaHead;
+   if (u8DmaBackend == I2C_BACKEND_PIO_DMA)
+   {
+      // START, then the address byte, a NACK on it halts the state machine
+      if (!i2cDmaPut(&u32Head, 1u << PIO_I2C_ICOUNT_LSB) ||
+          !i2cDmaPut(&u32Head, set_scl_sda_program_instructions[I2C_SC1_SD0]) ||
+          !i2cDmaPut(&u32Head, set_scl_sda_program_instructions[I2C_SC0_SD0]) ||
+          !i2cDmaPut(&u32Head, (iAddr << 2) | (1u << PIO_I2C_NAK_LSB)))
+         goto i2c_dma_cancelled;
+   }
+   for (i=0; i<iTotal; i++)
+   {
+      bFinal = (i == iTotal-1);
+      if (iControl >= 0)
+         b = (i == 0) ? (uint8_t)iControl : pData[i-1];
+      else
+         b = pData[i];
+      if (u8DmaBackend == I2C_BACKEND_HW_DMA)
+         u16 = b | (bFinal ? I2C_IC_DATA_CMD_STOP_BITS : 0);
+      else
+         u16 = (b << PIO_I2C_DATA_LSB) | (bFinal << PIO_I2C_FINAL_LSB) | (1u << PIO_I2C_NAK_LSB);
+      if (!i2cDmaPut(&u32Head, u16))
+         goto i2c_dma_cancelled;
+   }
+   if (u8DmaBackend == I2C_BACKEND_PIO_DMA)
+   {
+      // STOP
+      if (!i2cDmaPut(&u32Head, 2u << PIO_I2C_ICOUNT_LSB) ||
+          !i2cDmaPut(&u32Head, set_scl_sda_program_instructions[I2C_SC0_SD0]) ||
+          !i2cDmaPut(&u32Head, set_scl_sda_program_instructions[I2C_SC1_SD0]) ||
+          !i2cDmaPut(&u32Head, set_scl_sda_program_instructions[I2C_SC1_SD1]))
+         goto i2c_dma_cancelled;
+   }
+   irq_set_enabled(DMA_IRQ_1, false);
+   if (pfnDone)
+      i2cDmaAddDone(u32Head, pfnDone, pUser);
+   u32DmaHead = u32Head;
+   i2cDmaKick();
+   irq_set_enabled(DMA_IRQ_1, true);
+   return rc;
+
+i2c_dma_cancelled: // NACKed while part of this write was already on the wire
+   bDmaAbort = 0;
+   if (pfnDone)
+      (*pfnDone)(pUser, 0);
+   return 0;
+} /* i2cDmaWrite() */
+
+//
+// Blocking transfer on the PIO backend, used for probing and reads.
+// Writes pTx (if any), then reads into pRx (if any) after a repeated start.
+// With nothing to send or receive it only checks that the address ACKs.
+// returns 1 for success, 0 for a NACK
+//
+static int i2cPioXfer(BBI2C *pI2C, uint8_t iAddr, uint8_t *pTx, int iTxLen, uint8_t *pRx, int iRxLen)
+{
+int i, iTxRemain, bFirst, rc = 1;
+
+   I2CWait(pI2C); // the FIFO is ours once the ring has drained
+   i2cPioPut16(1u << PIO_I2C_ICOUNT_LSB); // START
+   i2cPioPut16(set_scl_sda_program_instructions[I2C_SC1_SD0]);
+   i2cPioPut16(set_scl_sda_program_instructions[I2C_SC0_SD0]);
+   if (iTxLen || !iRxLen)
+   {
+      i2cPioPut16((iAddr << 2) | (1u << PIO_I2C_NAK_LSB));
+      for (i=0; i<iTxLen; i++)
+         i2cPioPut16((pTx[i] << PIO_I2C_DATA_LSB) | ((i == iTxLen-1 && !iRxLen) << PIO_I2C_FINAL_LSB) | (1u << PIO_I2C_NAK_LSB));
+      if (iRxLen) // repeated start
+      {
+         i2cPioPut16(3u << PIO_I2C_ICOUNT_LSB);
+         i2cPioPut16(set_scl_sda_program_instructions[I2C_SC0_SD1]);
+         i2cPioPut16(set_scl_sda_program_instructions[I2C_SC1_SD1]);
+         i2cPioPut16(set_scl_sda_program_instructions[I2C_SC1_SD0]);
+         i2cPioPut16(set_scl_sda_program_instructions[I2C_SC0_SD0]);
+      }
+   }
+   if (iRxLen)
+   {
+      // the ISR kept shifting during writes, empty it so the bytes line up
+      pio_sm_exec(pDmaPIO, iDmaSM, pio_encode_mov(pio_isr, pio_null));
+      hw_set_bits(&pDmaPIO->sm[iDmaSM].shiftctrl, PIO_SM0_SHIFTCTRL_AUTOPUSH_BITS);
+      while (!pio_sm_is_rx_fifo_empty(pDmaPIO, iDmaSM))
+         (void)pio_sm_get(pDmaPIO, iDmaSM);
+      i2cPioPut16((iAddr << 2) | 3u); // read address
+      iTxRemain = iRxLen; // 0xff bytes clock the data in
+      bFirst = 1;
+      while ((iTxRemain || iRxLen) && !pio_interrupt_get(pDmaPIO, iDmaSM))
+      {
+         if (iTxRemain && !pio_sm_is_tx_fifo_full(pDmaPIO, iDmaSM))
+         {
+            --iTxRemain;
+            i2cPioPut16((0xffu << PIO_I2C_DATA_LSB) | (iTxRemain ? 0 : (1u << PIO_I2C_FINAL_LSB) | (1u << PIO_I2C_NAK_LSB)));
+         }
+         if (!pio_sm_is_rx_fifo_empty(pDmaPIO, iDmaSM))
+         {
+            if (bFirst) // the address byte comes back first
+            {
+               (void)pio_sm_get(pDmaPIO, iDmaSM);
+               bFirst = 0;
+            }
+            else
+            {
+               --iRxLen;
+               *pRx++ = (uint8_t)pio_sm_get(pDmaPIO, iDmaSM);
+            }
+         }
+      }
+   }
+   i2cPioStop();
+   rc = I2CWait(pI2C);
+   hw_clear_bits(&pDmaPIO->sm[iDmaSM].shiftctrl, PIO_SM0_SHIFTCTRL_AUTOPUSH_BITS);
+   return rc;
+} /* i2cPioXfer() */
+//
 // Initialize the I2C BitBang library
 // Pass the pin numbers used for SDA and SCL
 // as well as the clock rate in Hz
@@ -215,6 +675,12 @@ void I2CInit(BBI2C *pI2C, uint32_t iClock)
 {
    if (pI2C == NULL) return;
 
+   if (pI2C->bWire == I2C_BACKEND_HW_DMA || pI2C->bWire == I2C_BACKEND_PIO_DMA)
+   {
+      i2cDmaInit(pI2C, iClock);
+      return;
+   }
+
    if (pI2C->bWire) // use Wire library
    {
       i2c_init(i2c0, iClock);
@@ -226,27 +692,20 @@ void I2CInit(BBI2C *pI2C, uint32_t iClock)
    }
    if (pI2C->iSDA < 0xa0)
    {
-     gpio_init(pI2C->iSDA);
+     gpio_init(pI2C->iSDA); // SIO function, output latch 0
      gpio_init(pI2C->iSCL);
-//     gpio_set_dir(pI2C->iSDA, GPIO_OUT);
-//     gpio_set_dir(pI2C->iSCL, GPIO_OUT);
-//     gpio_put(pI2C->iSDA, LOW); // setting low = enabling as outputs
-//     gpio_put(pI2C->iSCL, LOW);
+     gpio_pull_up(pI2C->iSDA);
+     gpio_pull_up(pI2C->iSCL);
      gpio_set_dir(pI2C->iSDA, GPIO_IN); // let the lines float (tri-state)
      gpio_set_dir(pI2C->iSCL, GPIO_IN);
 
    }
-  // For now, we only support 100, 400 or 800K clock rates
-  // all other values default to 100K
-   if (iClock >= 1000000)
-      pI2C->iDelay = 0; // the code execution is enough delay
-   else if (iClock >= 800000)
-      pI2C->iDelay = 1;
-   else if (iClock >= 400000)
-      pI2C->iDelay = 2;
-   else if (iClock >= 100000)
-      pI2C->iDelay = 10;
-   else pI2C->iDelay = (uint16_t)(1000000 / iClock);
+   // half an SCL period in clk_sys cycles, less what the bit loop itself
+   // takes; at 125MHz 1MHz comes out at 50 cycles, 100K at 613
+   if (iClock == 0)
+      iClock = 100000;
+   pI2C->iDelay = clock_get_hz(clk_sys) / (2 * iClock);
+   pI2C->iDelay = (pI2C->iDelay > I2C_BB_OVERHEAD) ? pI2C->iDelay - I2C_BB_OVERHEAD : 0;
 } /* i2cInit() */
 //
 // Test a specific I2C address to see if a device responds
@@ -256,11 +715,15 @@ uint8_t I2CTest(BBI2C *pI2C, uint8_t addr)
 {
 uint8_t response = 0;
 
+  if (pI2C->bWire == I2C_BACKEND_PIO_DMA)
+     return i2cPioXfer(pI2C, addr, NULL, 0, NULL, 0);
   if (pI2C->bWire)
   {
      int ret;
      uint8_t rxdata;
-     ret = i2c_read_blocking(i2c0, addr, &rxdata, 1, false);
+     I2CWait(pI2C);
+     u8DmaAddr = 0xff; // the SDK calls below reprogram TAR
+     ret = i2c_read_blocking(i2cHW(pI2C), addr, &rxdata, 1, false);
      return (ret >= 0);
   }
   if (i2cBegin(pI2C, addr, 0)) // try to write to the given address
@@ -297,6 +760,8 @@ int I2CWrite(BBI2C *pI2C, uint8_t iAddr, uint8_t *pData, int iLen)
 {
   int rc = 0;
   
+  if (pI2C->bWire == I2C_BACKEND_HW_DMA || pI2C->bWire == I2C_BACKEND_PIO_DMA)
+    return i2cDmaWrite(pI2C, iAddr, -1, pData, iLen, NULL, NULL);
   if (pI2C->bWire)
   {
     rc = i2c_write_blocking(i2c0, iAddr, pData, iLen, true); // true to keep master control of bus
@@ -311,17 +776,86 @@ int I2CWrite(BBI2C *pI2C, uint8_t iAddr, uint8_t *pData, int iLen)
   return rc; // returns the number of bytes sent or 0 for error
 } /* I2CWrite() */
 //
+// Write a control byte followed by a block of data as one transfer
+// The DMA backends only queue it, the other two send it right away
+//
+int I2CWriteQueued(BBI2C *pI2C, uint8_t iAddr, uint8_t u8Control, uint8_t *pData, int iLen, I2CCALLBACK pfnDone, void *pUser)
+{
+  int rc, iChunk;
+  uint8_t ucTemp[I2C_WIRE_CHUNK+1];
+
+  if (pI2C->bWire == I2C_BACKEND_HW_DMA || pI2C->bWire == I2C_BACKEND_PIO_DMA)
+    return i2cDmaWrite(pI2C, iAddr, u8Control, pData, iLen, pfnDone, pUser);
+  if (pI2C->bWire)
+  {
+    // the SDK wants the whole transfer in one buffer, longer blocks go out
+    // as several transfers that each start with the control byte
+    rc = 0;
+    ucTemp[0] = u8Control;
+    do {
+      iChunk = (iLen > I2C_WIRE_CHUNK) ? I2C_WIRE_CHUNK : iLen;
+      memcpy(&ucTemp[1], pData, iChunk);
+      if (i2c_write_blocking(i2c0, iAddr, ucTemp, iChunk+1, false) < 0)
+      {
+        rc = 0;
+        break;
+      }
+      rc += iChunk+1;
+      pData += iChunk;
+      iLen -= iChunk;
+    } while (iLen);
+  }
+  else
+  {
+    rc = i2cBegin(pI2C, iAddr, 0);
+    if (rc == 1)
+      rc = i2cByteOut(pI2C, u8Control);
+    if (rc == 1)
+      rc = (iLen == 0) ? 1 : i2cWrite(pI2C, pData, iLen);
+    if (rc)
+      rc = iLen + 1;
+    i2cEnd(pI2C);
+  }
+  if (pfnDone)
+    (*pfnDone)(pUser, rc != 0);
+  return rc;
+} /* I2CWriteQueued() */
+//
+// Call pfnDone once everything queued so far has gone to the controller
+//
+void I2CFence(BBI2C *pI2C, I2CCALLBACK pfnDone, void *pUser)
+{
+  if ((pI2C->bWire != I2C_BACKEND_HW_DMA && pI2C->bWire != I2C_BACKEND_PIO_DMA) || iDmaChan < 0)
+  {
+    (*pfnDone)(pUser, 1); // nothing is ever left queued
+    return;
+  }
+  irq_set_enabled(DMA_IRQ_1, false);
+  if (u32DmaHead == u32DmaTail && u32DoneHead == u32DoneTail)
+  {
+    irq_set_enabled(DMA_IRQ_1, true);
+    (*pfnDone)(pUser, 1);
+    return;
+  }
+  i2cDmaAddDone(u32DmaHead, pfnDone, pUser);
+  irq_set_enabled(DMA_IRQ_1, true);
+} /* I2CFence() */
+//
 // Read N bytes starting at a specific I2C internal register
 //
 int I2CReadRegister(BBI2C *pI2C, uint8_t iAddr, uint8_t u8Register, uint8_t *pData, int iLen)
 {
   int rc;
   
+  if (pI2C->bWire == I2C_BACKEND_PIO_DMA)
+      return i2cPioXfer(pI2C, iAddr, &u8Register, 1, pData, iLen);
   if (pI2C->bWire) // use the wire library
   {
-      rc = i2c_write_blocking(i2c0, iAddr, &u8Register, 1, true); // true to keep master control of bus 
+      I2CWait(pI2C);
+      u8DmaAddr = 0xff; // the SDK calls below reprogram TAR
+      rc = i2c_write_blocking(i2cHW(pI2C), iAddr, &u8Register, 1, true); // true to keep master control of bus 
       if (rc >= 0) {
-         rc = i2c_read_blocking(i2c0, iAddr, pData, iLen, false);
+         rc = i2c_read_blocking(i2cHW(pI2C), iAddr, pData, iLen, false);
       }
       return (rc >= 0);
   }
@@ -340,7 +874,7 @@ int I2CReadRegister(BBI2C *pI2C, uint8_t iAddr, uint8_t u8Register, uint8_t *pDa
      }
   }
   i2cEnd(pI2C);
-  return rc; // returns 1 for success, 0 for error
+  return rc && !bStretchTimeout; // returns 1 for success, 0 for error
 } /* I2CReadRegister() */
 //
 // Read N bytes
@@ -349,9 +883,13 @@ int I2CRead(BBI2C *pI2C, uint8_t iAddr, uint8_t *pData, int iLen)
 {
   int rc;
   
+    if (pI2C->bWire == I2C_BACKEND_PIO_DMA)
+       return i2cPioXfer(pI2C, iAddr, NULL, 0, pData, iLen);
     if (pI2C->bWire) // use the wire library
     {
-       rc = i2c_read_blocking(i2c0, iAddr, pData, iLen, false);
+       I2CWait(pI2C);
+       u8DmaAddr = 0xff; // the SDK calls below reprogram TAR
+       rc = i2c_read_blocking(i2cHW(pI2C), iAddr, pData, iLen, false);
        return (rc >= 0);
     }
   rc = i2cBegin(pI2C, iAddr, 1);
@@ -360,7 +898,7 @@ int I2CRead(BBI2C *pI2C, uint8_t iAddr, uint8_t *pData, int iLen)
      i2cRead(pI2C, pData, iLen);
   }
   i2cEnd(pI2C);
-  return rc; // returns 1 for success, 0 for error
+  return rc && !bStretchTimeout; // returns 1 for success, 0 for error
 } /* I2CRead() */
 //
 // Figure out what device is at that address
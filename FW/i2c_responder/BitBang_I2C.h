@@ -60,12 +60,24 @@ enum {
 #define HIGH 1
 #endif
 
+// Bus backends, stored in BBI2C.bWire
+enum {
+  I2C_BACKEND_BITBANG = 0, // software I2C on any two GPIOs
+  I2C_BACKEND_WIRE,        // blocking hardware I2C0
+  I2C_BACKEND_HW_DMA,      // hardware I2C block of the SDA/SCL pins fed by DMA, writes return at once
+  I2C_BACKEND_PIO_DMA      // PIO state machine on pio1 fed by DMA, any pins with SCL = SDA + 1
+};
+
+// Completion callback for I2CWriteQueued()/I2CFence(), bOK is 0 if the
+// transfer (or one queued ahead of the fence) was NACKed. May run in the DMA
+// interrupt, keep it short.
+typedef void (*I2CCALLBACK)(void *pUser, int bOK);
 typedef struct mybbi2c
 {
 uint8_t iSDA, iSCL; // pin numbers (0xff = disabled)
-uint8_t bWire; // use the Wire library
+uint8_t bWire; // backend, one of I2C_BACKEND_xxx (non-zero = hardware I2C)
 uint8_t iSDABit, iSCLBit; // bit numbers of the ports
-uint32_t iDelay;
+uint32_t iDelay; // bit-bang: clk_sys cycles per half SCL period
 } BBI2C;
 //
 // Read N bytes
@@ -82,6 +94,29 @@ int I2CReadRegister(BBI2C *pI2C, uint8_t iAddr, uint8_t u8Register, uint8_t *pDa
 //
 int I2CWrite(BBI2C *pI2C, uint8_t iAddr, uint8_t *pData, int iLen);
 //
+// Write a control byte followed by iLen bytes of pData as one transfer,
+// e.g. 0x00 (commands) or 0x40 (pixel data) for an SSD1306. With the DMA
+// backends the bytes are copied into the queue and the call returns at once,
+// so pData can be reused right away; pfnDone (may be NULL) then runs from the
+// DMA interrupt when the last byte has gone to the controller. The blocking
+// backends send it before returning and call pfnDone from here.
+// returns the number of bytes written/queued or 0 for a NACK (of this
+// transfer or, with the DMA backends, of an earlier one)
+//
+int I2CWriteQueued(BBI2C *pI2C, uint8_t iAddr, uint8_t u8Control, uint8_t *pData, int iLen, I2CCALLBACK pfnDone, void *pUser);
+//
+// Fence: pfnDone runs once everything queued so far has gone to the
+// controller, at once if nothing is queued
+//
+void I2CFence(BBI2C *pI2C, I2CCALLBACK pfnDone, void *pUser);
+//
+// Wait until every queued write has left the wire (I2C_BACKEND_xx_DMA)
+// With the DMA backends I2CWrite only queues the data, a NACK shows up here
+// or as a 0 return from the next I2CWrite.
+// returns 1 if the last transfer was acknowledged, 0 for a NACK
+//
+int I2CWait(BBI2C *pI2C);
+//
 // Scans for I2C devices on the bus
 // returns a bitmap of devices which are present (128 bits = 16 bytes, LSB first)
 //
@@ -97,6 +132,10 @@ void I2CScan(BBI2C *pI2C, uint8_t *pMap);
 // Initialize the I2C BitBang library
 // Pass the pin numbers used for SDA and SCL
 // as well as the clock rate in Hz
+// bWire picks the backend. The DMA backends run at 1MHz and beyond
+// (PIO) and only one bus can use one of them at a time
+// The bit-bang timing is derived from clk_sys, call it again after changing
+// the system clock
 //
 void I2CInit(BBI2C *pI2C, uint32_t iClock);
 //
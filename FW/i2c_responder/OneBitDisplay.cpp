@@ -34,13 +34,9 @@
 #define HIGH 1
 #define LOW 0
 void delay(int);
-#else // Arduino
+#else // pico-sdk
 
-#include <Arduino.h>
-#ifdef __AVR__
-#include <avr/pgmspace.h>
-#endif
-#include <SPI.h>
+#include "obd_pico.h" // the Arduino calls the library makes
 
 #endif // _LINUX_
 #include "OneBitDisplay.h"
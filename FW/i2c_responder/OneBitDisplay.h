@@ -2,7 +2,7 @@
 #define __ONEBITDISPLAY__
 
 #ifndef MEMORY_ONLY
-#include <BitBang_I2C.h>
+#include "BitBang_I2C.h"
 #endif
 
 #ifdef _LINUX_
@@ -15,6 +15,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#else
+#include "obd_pico.h" // Print and the rest of the Arduino API
 #endif // _LINUX_
 
 // 5 possible font sizes: 8x8, 16x32, 6x8, 12x16 (stretched from 6x8 with smoothing), 16x16 (stretched from 8x8)
@@ -24,10 +24,10 @@
 #include "hardware/timer.h"
 #include "hardware/gpio.h"
 #include "hardware/flash.h"
-#include "ss_oled.h"
 
 #include "pico/stdio.h"
 #include "pico/time.h"
+#include "pico/multicore.h"
 #include <tusb.h>
 #include "Adafruit_NeoPixel.hpp"
 
@@ -37,6 +37,23 @@
 #include <math.h>
 
 #include "i2c_jogger.h"
+#include "jog_task.h"
+#include "jog_sched.h"
+#include "jog_widget.h"
+#include "jog_dro.h"
+#include "jog_notify.h"
+#include "jog_ticker.h"
+#include "jog_display.h"
+#include "jog_mailbox.h"
+#include "jog_history.h"
+#include "jog_spark.h"
+#include "jog_page.h"
+#include "jog_asset.h"
+#include "jog_assets.h" // splash and icons, built from assets/ by tools/fontc.cpp
+
+static_assert(BOARD_OLED_128x64 == OLED_128x64 && BOARD_OLED_132x64 == OLED_132x64, "board_profile.h OLED types out of sync with the display backend");
+static_assert(BOARD_OLED_BUS_BITBANG == I2C_BACKEND_BITBANG && BOARD_OLED_BUS_HW_DMA == I2C_BACKEND_HW_DMA &&
+              BOARD_OLED_BUS_PIO_DMA == I2C_BACKEND_PIO_DMA, "board_profile.h OLED buses out of sync with BitBang_I2C.h");
 
 //#define SHOWJOG 1
 //#define SHOWOVER 1
@@ -45,9 +62,53 @@
 
 #define OLED_SCREEN_FLIP 1
 
-#define TICK_TIMER_PERIOD 10
+#define TICK_TIMER_PERIOD 10 // jog engine tick, ms
 #define ROLLOVER_DELAY_PERIOD 7
 
+#define LINK_QUEUE_SIZE 8
+#define LINK_STROBE_SETUP_US 1000 // character must sit in RAM this long before the strobe
+#define LINK_STROBE_GAP_MS 5      // strobe low time between two jog directions
+#define MACRO_SETTLE_MS 10        // settle time after macros and shifted functions
+#define RESET_SCREEN_MS 500
+#define COMMAND_ERR_MS 2000        // how long a rejected command is reported
+#define ALARM_NOTICE_MS 3000
+#define SCREENFLIP_SETTLE_MS 250
+#define LOOP_STALL_BUDGET_US 25000 // longest main loop pass that is not counted as a stall
+#define LOOP_CHECK_MS 10000        // the loop is checked against the budget this long after start-up
+#define LOOP_STALL_NOTICE_MS 5000
+// RENDER_CORE1 (the render side runs on the second core) is set by cmake -DJOG2K_RENDER_CORE1=ON, the default
+#ifndef RENDER_CORE1
+#define RENDER_CORE1 0
+#endif
+
+// Scheduler task periods and execution budgets
+#define LINK_PERIOD_US 20000      // backstop, the link is triggered by new characters and the controller's I2C
+#define LINK_BUSY_PERIOD_US 250    // while a character is in flight
+#define INPUT_PERIOD_US 2000
+#define RENDER_MAX_FPS 25          // render governor, the screen is never redrawn faster than this
+#define RENDER_FRAME_US (1000000 / RENDER_MAX_FPS)
+#define RENDER_PERIOD_US (RENDER_FRAME_US / 4) // polls for a dirty screen, a frame starts at most this late
+#define RENDER_SLICE_US 1500       // render work per pass, a frame is spread over as many passes as it needs
+#define HOUSE_PERIOD_US 50000
+#define STATUS_REFRESH_MS (STATUS_REQUEST_PERIOD * TICK_TIMER_PERIOD) // idle screen refresh
+#ifndef HISTORY_PERIOD_MS
+#define HISTORY_PERIOD_MS 500      // feed/RPM history sample rate, the sparklines move a column per sample
+#endif
+#define LINK_BUDGET_US 100
+#define PUBLISH_BUDGET_US 200
+#define INPUT_BUDGET_US 500
+#define JOG_BUDGET_US 200
+#define RENDER_BUDGET_US 4000      // RENDER_SLICE_US plus the one unit that may overrun it
+#define LEDS_BUDGET_US 1000
+#define HOUSE_BUDGET_US 15000
+// SHOWSCHED (print the task statistics over stdio every SCHED_REPORT_MS) is set by cmake -DJOG2K_SHOWSCHED=ON,
+// the report blocks core0 for tens of ms on the UART
+#define SCHED_REPORT_MS 10000
+#define OLED_BUS_HZ 1000000L
+// BENCH_OLED_BUS (time a full frame on the OLED bus backends at boot) is set by cmake -DJOG2K_BENCH_OLED_BUS=ON
+// BENCH_DRO (compare dro_format() with printf at boot) by -DJOG2K_BENCH_DRO=ON
+// BENCH_DISPLAY (time drawing and flushing on the display backend) by -DJOG2K_BENCH_DISPLAY=ON
+
 
 uint8_t jog_color[] = {0,255,0};
 uint8_t halt_color[] = {0,255,0};
@@ -64,26 +125,31 @@ static const uint I2C_SLAVE_ADDRESS = 0x49;
 static const uint I2C_BAUDRATE = 100000; // 100 kHz
 
 // GPIO pins to use for I2C SLAVE
-static const uint I2C_SLAVE_SDA_PIN = 0;
-static const uint I2C_SLAVE_SCL_PIN = 1;
+static const uint I2C_SLAVE_SDA_PIN = board.slave_sda_pin;
+static const uint I2C_SLAVE_SCL_PIN = board.slave_scl_pin;
 
 // RPI Pico
 
 int rc;
-SSOLED oled;
-static uint8_t ucBuffer[1024];
+uint32_t oled_frames = 0;      // frames flushed by render_slice()
+uint32_t oled_frame_bytes = 0; // I2C bytes of the last frame
+uint32_t ui_redraws_avoided = 0; // packets whose floats changed but not their text on screen
+uint64_t oled_total_bytes = 0;
+uint32_t loop_max_us = 0;       // longest main loop pass since the last report
+uint32_t loop_passes = 0;       // main loop passes that ran a task, since the last report
+uint64_t loop_total_us = 0;     // time they took
+uint32_t loop_stalls = 0;       // passes over LOOP_STALL_BUDGET_US since the last report
+uint32_t loop_check_max_us = 0; // longest pass of the start-up loop check
+uint32_t loop_check_stalls = 0; // its passes over LOOP_STALL_BUDGET_US
+bool loop_check_done = false;
 bool screenflip = false;
 bool joggle_reset =false;
+bool hold_latched = false; //HOLD/RUN fire once per press
+bool run_latched = false;
 
-int led_update_counter = 0;
-int update_neopixel_leds = 0;
-int screen_update_counter = 0;
-int status_update_counter = 0;
-int onboard_led_count = 0;
+bool buttons_idle = false; //last scan found no button pressed
 int jogmode = 0;
 
-int command_error = 0;
-
 // ram_addr is the current address to be used when writing / reading the RAM
 // N.B. the address auto increments, as stored in 8 bit value it automatically rolls round when reaches 255
 
@@ -113,6 +179,8 @@ uint8_t spin_down_pressed = 0;
 uint8_t spin_up_fine_pressed = 0;
 uint8_t spin_down_fine_pressed = 0;
 uint8_t spin_reset_pressed = 0;
+uint8_t page_next_pressed = 0; //shift + feed override reset
+uint8_t page_prev_pressed = 0; //shift + spindle override reset
 
 uint8_t jog_mod_pressed = 0;
 uint8_t jog_mode_pressed = 0;
@@ -149,8 +217,43 @@ machine_status_packet_t *previous_packet = &prev_packet;
 ScreenMode previous_screenmode = DEFAULT;
 
 char *ram_ptr = (char*) &context.mem[0];
+
+// The render side never reads the packet RAM the controller writes into.
+// publish_task() copies it, with the UI state that goes with it, into the
+// mailbox whenever either changed, render_receive() takes the newest copy.
+// The render side may be on the other core (RENDER_CORE1).
+typedef struct {
+  machine_status_packet_t packet;
+  ScreenMode screenmode;
+  uint32_t link_packets, link_sent, link_errors;
+} render_snapshot_t;
+
+// Events for the render side, posted to the mailbox queue
+enum {
+  RENDER_EV_REFRESH = 0, // redraw, whether or not anything changed
+  RENDER_EV_COMMAND_ERR, // the controller did not pick a character up
+  RENDER_EV_RESETTING,   // a reset was sent
+  RENDER_EV_PAGE_NEXT,   // shift + feed override reset
+  RENDER_EV_PAGE_PREV,   // shift + spindle override reset
+  RENDER_EV_LOOP_STALL   // the start-up loop check failed
+};
+
+static render_snapshot_t render_published; // mailbox buffer, only the mailbox touches it
+static mailbox_t render_mailbox = MAILBOX_INIT(render_published);
+static render_snapshot_t snap;              // the render side's copy
+static uint32_t snap_seq = 0;
 int character_sent;
 
+// set from interrupts, consumed by the scheduler tasks
+volatile bool packet_event = false; // controller finished a write or read
+volatile bool input_event = false;  // a button changed state
+volatile bool link_event = false;   // controller finished a write or read, for link_task()
+
+// link statistics for the LINK page
+volatile uint32_t link_packets = 0; // controller writes and reads
+uint32_t link_sent = 0;             // characters strobed out
+uint32_t link_errors = 0;           // characters the controller did not pick up
+
 // Our handler is called from the I2C ISR, so it must complete quickly. Blocking calls /
 // printing to stdio may interfere with interrupt handling.
 static void i2c_slave_handler(i2c_inst_t *i2c, i2c_slave_event_t event) {
@@ -174,6 +277,10 @@ static void i2c_slave_handler(i2c_inst_t *i2c, i2c_slave_event_t event) {
         break;
     case I2C_SLAVE_FINISH: // master has signalled Stop / Restart
         context.mem_address_written = false;
+        packet_event = true; // wake the main loop, render_task() decides if anything changed
+        link_event = true;   // it may have picked up the character in flight
+        link_packets++;
+        __sev();
         break;
     default:
         break;
@@ -194,43 +301,86 @@ static void setup_slave() {
     i2c_slave_init(i2c0, I2C_SLAVE_ADDRESS, &i2c_slave_handler);
 }
 
+// Any button edge wakes the core out of sched_idle() and gets the scanner
+// going without waiting for its next release.
+static void button_irq_callback(uint gpio, uint32_t events) {
+    input_event = true;
+    __sev();
+}
+
+static void setup_button_irqs() {
+    gpio_set_irq_enabled_with_callback(board.button[0], GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true, &button_irq_callback);
+    for (int b = 1; b < BUTTON_COUNT; b++)
+        gpio_set_irq_enabled(board.button[b], GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true);
+}
+
 uint8_t adjust (uint8_t value) {
 	if (NEO_BRIGHTNESS == 0) return value ;
 	return ((value * neopixels_gamma8(NEO_BRIGHTNESS)) >> 8) ;
 };
 
-volatile bool timer_fired = false;
+// Characters for the controller go through a small queue that link_task()
+// strobes out in the background, so no caller ever waits for the handshake.
+enum {
+  LINK_CLEAR_STROBE = 0x01, // drop the strobe once the controller has read the character
+  LINK_STROBE_GAP   = 0x02, // hold the strobe low for LINK_STROBE_GAP_MS before sending
+  LINK_REFRESH_LEDS = 0x04, // refresh the NeoPixels once the settle time is over
+  LINK_RESET_SCREEN = 0x08  // show the reset notice for RESET_SCREEN_MS after sending
+};
 
-uint8_t keypad_sendchar (uint8_t character, bool clearpin, bool update_status) {
-  //maybe use key_pressed variable to avoid spamming?
-  int timeout = I2C_TIMEOUT_VALUE;
+typedef struct {
+  uint8_t character;
+  uint8_t flags;
+  uint16_t settle_ms; // wait after the controller picked the character up
+} link_cmd_t;
+
+static link_cmd_t link_queue[LINK_QUEUE_SIZE];
+static uint8_t link_head = 0, link_tail = 0;
+static link_cmd_t link_cmd; // command in flight
+static bool link_busy = false;
+static task_t link_state;
+static absolute_time_t link_deadline;
+static void link_poll(void);
+
+static bool link_idle (void) {
+  return !link_busy && link_head == link_tail;
+}
 
-  command_error = 0;
+// queue a character, returns false if the queue is full
+static bool keypad_sendchar (uint8_t character, uint8_t flags, uint16_t settle_ms) {
+  uint8_t next = (link_head + 1) % LINK_QUEUE_SIZE;
+
+  if (next == link_tail)
+    return false;
+  link_queue[link_head].character = character;
+  link_queue[link_head].flags = flags;
+  link_queue[link_head].settle_ms = settle_ms;
+  link_head = next;
+  sched_trigger(link_poll);
+  return true;
+};
 
-  gpio_put(ONBOARD_LED, 0);
+// Called when no button is pressed: any jog character that keeps the strobe
+// asserted is dropped, then the strobe is released.
+static void link_release_strobe (void) {
+  uint8_t i, j = link_tail;
 
-  while (context.mem_address_written != false && context.mem_address>0);
-
-  context.mem[0] = character;
-  context.mem_address = 0;
-  //gpio_put(KPSTR_PIN, false);
-  sleep_us(1000);
-  gpio_put(KPSTR_PIN, true);
-  //sleep_us(100);
-  while (context.mem_address == 0 && timeout){
-    sleep_us(1);      
-    timeout = timeout - 1;}
-
-  if(!timeout)
-    command_error = 1;
-  //sleep_ms(2);
-  if (clearpin){
-    //sleep_ms(5);
-    gpio_put(KPSTR_PIN, false);
+  for (i = link_tail; i != link_head; i = (i + 1) % LINK_QUEUE_SIZE) {
+    if (link_queue[i].flags & LINK_CLEAR_STROBE) {
+      link_queue[j] = link_queue[i];
+      j = (j + 1) % LINK_QUEUE_SIZE;
+    }
   }
-  gpio_put(ONBOARD_LED, 1);
-  return true;
-};
+  link_head = j;
+
+  if (link_busy && !(link_cmd.flags & LINK_CLEAR_STROBE)) {
+    TASK_INIT(&link_state); // abandon the jog character in flight
+    link_busy = false;
+    gpio_put(ONBOARD_LED, 1);
+  }
+  if (!link_busy)
+    gpio_put(KPSTR_PIN, false);
+}
 
 static void update_neopixels(void){
 
@@ -438,476 +588,1599 @@ static char *map_coord_system (coord_system_id_t id)
     return buf;
 }
 
-static void draw_main_screen(bool force){ 
-  int i = 0;
-  int j = 0;
-  char charbuf[32];
+// A frame goes through the phases one unit at a time, a widget to draw or a
+// page row to send, see render_slice()
+enum { RENDER_IDLE, RENDER_DRAW, RENDER_FLUSH };
+static uint8_t render_phase = RENDER_IDLE;
+static int8_t render_row = -1; // next page row to send, -1 = send the frame in one go
+
+// Feed and spindle history on the row above the overrides, left of the
+// spindle label, in the layouts that show the spindle
+#define SPARKLINE 6
+static spark_t feed_spark = {0, SPARKLINE, 46, HISTORY_FEED, 0, 0};
+static spark_t rpm_spark = {50, SPARKLINE, 46, HISTORY_RPM, 0, 0};
+static bool sparks_shown = false;
+static uint32_t history_next_us = 0; // time_us_32() of the next sample
+
+static bool render_content = false; // the frame in progress has more than the ticker in it
+
+static void render_flush_begin(void) {
+  render_phase = RENDER_FLUSH;
+  render_row = display_flush_by_row() ? 0 : -1;
+  ticker_flush(render_content); //a hardware scroll stops before the RAM is written
+  ticker_draw();
+  if (sparks_shown){
+    spark_update(&feed_spark);
+    spark_update(&rpm_spark);
+  }
+  oled_frame_bytes = 0;
+}
 
-  int x, y;
+// Render governor: whatever changes the screen content calls ui_invalidate(),
+// render_task() draws at most one frame per RENDER_FRAME_US, from the packet
+// as it is by then, so any number of changes in between cost one frame.
+static bool ui_dirty = false;
+static bool ui_content = false;      // dirty for more than the ticker
+static bool ui_force = false;        // redraw every widget, not just the changed ones
+static uint32_t ui_frame_start = 0;  // time_us_32() of the last governed frame
+
+static void ui_invalidate(bool force) {
+  ui_dirty = true;
+  ui_content = true;
+  ui_force |= force;
+}
 
-  #define JOGLINE 7
-  #define JOGFONT FONT_8x8
-  #define TOPLINE 2
-  #define INFOLINE 0
-  #define BOTTOMLINE 7
-  #define INFOFONT FONT_8x8
+#define JOGLINE 7
+#define JOGFONT FONT_8x8
+#define TOPLINE 2
+#define INFOLINE 0
+#define BOTTOMLINE 7
+#define INFOFONT FONT_8x8
+#define STARS " *****************"
+
+// Widget data sources, each formats one field of the status packet
+static void fmt_axis(char *text, char axis, float value){
+  text[0] = axis;
+  text[1] = ' ';
+  dro_format(text + 2, value, 8, dro_decimals(snap.packet.machine_modes.reports_imperial == 1));
+}
+static void fmt_x(char *text){ fmt_axis(text, 'X', snap.packet.coordinate.x); }
+static void fmt_y(char *text){ fmt_axis(text, 'Y', snap.packet.coordinate.y); }
+static void fmt_z(char *text){ fmt_axis(text, 'Z', snap.packet.coordinate.z); }
+
+// A is blank on machines without a fourth axis
+static void fmt_a(char *text){
+  text[0] = 0;
+  if(!isnan(snap.packet.coordinate.a))
+    fmt_axis(text, 'A', snap.packet.coordinate.a);
+}
 
-  //while(context.mem_address < sizeof(Machine_status_packet));
+// While jogging the axis that moves last is shown in the DRO font, the
+// others small below it
+static int jog_axis = 0; // 0..3 = X..A
+static const char axis_letters[] = "XYZA";
+static void fmt_jog_axis(char *text, int slot){
+  int axis = slot == 0 ? jog_axis : slot - (slot <= jog_axis); // the others in order
 
-  /*if(screenmode != previous_screenmode){
-    oledFill(&oled, 0,1);  //only clear screen if the mode changes.
-    force = 1;
-  }*/
-  
-  switch (screenmode){
-  case JOG_MODIFY:
-  case JOGGING: 
-  case RUN:   
-  case DEFAULT:  
+  text[0] = 0;
+  if (!isnan(snap.packet.coordinate.values[axis]))
+    fmt_axis(text, axis_letters[axis], snap.packet.coordinate.values[axis]);
+}
+// The jogged axis is drawn in two boxes: FONT_12x16 only has DRO glyphs for
+// the digits, sign and point, so its letter is in FONT_8x8
+static void fmt_jog_letter(char *text){
+  text[0] = 0;
+  if (!isnan(snap.packet.coordinate.values[jog_axis])){
+    text[0] = axis_letters[jog_axis];
+    text[1] = 0;
+  }
+}
+static void fmt_jog_value(char *text){
+  text[0] = 0;
+  if (!isnan(snap.packet.coordinate.values[jog_axis]))
+    dro_format(text, snap.packet.coordinate.values[jog_axis], 8, dro_decimals(snap.packet.machine_modes.reports_imperial == 1));
+}
+static void fmt_jog_axis1(char *text){ fmt_jog_axis(text, 1); }
+static void fmt_jog_axis2(char *text){ fmt_jog_axis(text, 2); }
+static void fmt_jog_axis3(char *text){ fmt_jog_axis(text, 3); }
 
-      /*if(packet->machine_state != previous_packet->machine_state)
-        oledFill(&oled, 0,1);//clear screen on state change*/
-
-      switch (packet->system_state){
-        case SystemState_Jog : //jogging is allowed       
-        case SystemState_Idle : //jogging is allowed
-        if (packet->jog_mode.value!=previous_packet->jog_mode.value || packet->jog_stepsize!=previous_packet->jog_stepsize || force){
-          sprintf(charbuf, "        : %3.3f ", packet->jog_stepsize * (packet->machine_modes.reports_imperial ? 0.03937f : 1.0f));
-          oledWriteString(&oled, 0,0,INFOLINE,charbuf, INFOFONT, 0, 1);
-          switch (packet->jog_mode.mode) {
-            case FAST :
-            case SLOW : 
-              oledWriteString(&oled, 0,0,INFOLINE,(char *)"JOG FEED", INFOFONT, 0, 1); 
-              break;
-            case STEP : 
-              oledWriteString(&oled, 0,0,INFOLINE,(char *)"JOG STEP", INFOFONT, 0, 1);
-              break;
-            default :
-              //oledWriteString(&oled, 0,0,INFOLINE,(char *)"ERR ", INFOFONT, 0, 1);
-            break; 
-              }//close jog states
-        }
+static void fmt_wcs(char *text){
+  snprintf(text, WIDGET_TEXT_MAX + 1, "G%s", map_coord_system(snap.packet.current_wcs));
+}
 
-        if (packet->current_wcs != previous_packet->current_wcs || force){
-          oledWriteString(&oled, 0,0,2,(char *)"                G", FONT_6x8, 0, 1);
-          oledWriteString(&oled, 0,-1,-1,map_coord_system(packet->current_wcs), FONT_6x8, 0, 1);
-          oledWriteString(&oled, 0,-1,-1,(char *)"  ", FONT_6x8, 0, 1);
-        }
+// The jog step as the info line shows it, in the units the DRO is in
+static float jog_step_shown(const machine_status_packet_t *packet){
+  return packet->jog_stepsize * (packet->machine_modes.reports_imperial ? 0.03937f : 1.0f);
+}
 
-        oledWriteString(&oled, 0,94,4,(char *)" ", FONT_6x8, 0, 1);
-        switch (packet->system_state){
-          case SystemState_Idle :
-          oledWriteString(&oled, 0,-1,-1,(char *)"IDLE", FONT_6x8, 0, 1); 
-          break;
-          case SystemState_Jog :
-          oledWriteString(&oled, 0,-1,-1,(char *)"JOG ", FONT_6x8, 0, 1);
-          break;
-          case SystemState_ToolChange :
-          oledWriteString(&oled, 0,-1,-1,(char *)"TOOL", FONT_6x8, 0, 1); 
-          break;                   
-        }
-        //oledWriteString(&oled, 0,0,5,(char *)"              ", FONT_6x8, 0, 1);
-        //sprintf(charbuf, "%d %d %d  ", direction_pressed, previous_direction_pressed, transition_delay);
-        //oledWriteString(&oled, 0,-1,-1,charbuf, FONT_6x8, 0, 1); 
-
-        //oledWriteString(&oled, 2,0,2,(char *)"        ", FONT_8x8, 0, 1);
-        if(packet->coordinate.x != previous_packet->coordinate.x || 
-           packet->coordinate.y != previous_packet->coordinate.y || 
-           packet->coordinate.z != previous_packet->coordinate.z || 
-           packet->coordinate.a != previous_packet->coordinate.a || force){
-          if(packet->machine_modes.reports_imperial == 1)
-            sprintf(charbuf, "X %8.4F", packet->coordinate.x);
-          else
-            sprintf(charbuf, "X %8.3F", packet->coordinate.x);
-          oledWriteString(&oled, 0,0,2,charbuf, FONT_8x8, 0, 1);
-          //}
-          //oledWriteString(&oled, 2,0,3,(char *)"        ", FONT_8x8, 0, 1);
-          //if(packet->y_coordinate != previous_packet.y_coordinate || force){ 
-          if(packet->machine_modes.reports_imperial == 1)
-            sprintf(charbuf, "Y %8.4F", packet->coordinate.y);
-          else
-            sprintf(charbuf, "Y %8.3F", packet->coordinate.y);
-          oledWriteString(&oled, 0,0,3,charbuf, FONT_8x8, 0, 1);
-          //}
-          //oledWriteString(&oled, 2,0,4,(char *)"        ", FONT_8x8, 0, 1);
-          //if(packet->z_coordinate != previous_packet.z_coordinate || force){ 
-          if(packet->machine_modes.reports_imperial == 1)
-            sprintf(charbuf, "Z %8.4F", packet->coordinate.z);
-          else
-            sprintf(charbuf, "Z %8.3F", packet->coordinate.z);
-          oledWriteString(&oled, 0,0,4,charbuf, FONT_8x8, 0, 1);
-          //}
-          if(!isnan(packet->coordinate.a)){          
-            if(packet->machine_modes.reports_imperial == 1)
-              sprintf(charbuf, "A %8.4F", packet->coordinate.a);
-            else
-              sprintf(charbuf, "A %8.3F", packet->coordinate.a);
-            oledWriteString(&oled, 0,0,5,charbuf, FONT_8x8, 0, 1);
-          }else if (command_error){
-            sprintf(charbuf, "COMMAND ERR", packet->coordinate.a);
-            oledWriteString(&oled, 0,0,5,charbuf, FONT_8x8, 0, 1);
-            sleep_ms(100);            
-          }else{
-            sprintf(charbuf, "           ", packet->coordinate.a);
-            oledWriteString(&oled, 0,0,5,charbuf, FONT_8x8, 0, 1);            
-          }
-        }          
+static void fmt_jog_info(char *text){
+  const char *label;
+  char value[DRO_TEXT_MAX + 1];
+
+  switch (snap.packet.jog_mode.mode) {
+    case FAST :
+    case SLOW :
+      label = "JOG FEED";
+      break;
+    case STEP :
+      label = "JOG STEP";
+      break;
+    default :
+      label = "        ";
+      break;
+  }
+  dro_format(value, jog_step_shown(&snap.packet), 3, 3);
+  snprintf(text, WIDGET_TEXT_MAX + 1, "%s: %s ", label, value);
+}
 
-        if(packet->machine_modes.mode == Mode_Laser)
-          oledWriteString(&oled, 0,0,6,(char *)"                 PWR", FONT_6x8, 0, 1);
-        else
-          oledWriteString(&oled, 0,0,6,(char *)"                 RPM", FONT_6x8, 0, 1);
+static void fmt_feed_info(char *text){
+  char value[DRO_TEXT_MAX + 1];
 
-        sprintf(charbuf, "S:%3d  F:%3d    ", packet->spindle_override, packet->feed_override);
-        oledWriteString(&oled, 0,0,BOTTOMLINE,charbuf, FONT_6x8, 0, 1);
-        //this is the RPM number
-        sprintf(charbuf, "%5d", packet->spindle_rpm);
-        oledWriteString(&oled, 0,-1,-1,charbuf, FONT_6x8, 0, 1);            
-        break;//close idle state
+  dro_format(value, snap.packet.feed_rate, 3, 3);
+  snprintf(text, WIDGET_TEXT_MAX + 1, "RUN FEED: %s ", value);
+}
 
-        case SystemState_Cycle :
-          //can still adjust overrides during hold
-          //no jog during hold, show feed rate.
-          sprintf(charbuf, "        : %3.3f ", packet->feed_rate);
-          oledWriteString(&oled, 0,0,INFOLINE,charbuf, INFOFONT, 0, 1);
-
-          oledWriteString(&oled, 0,0,INFOLINE,(char *)"RUN FEED", INFOFONT, 0, 1); 
-
-          oledWriteString(&oled, 0,0,2,(char *)"                G", FONT_6x8, 0, 1);
-          oledWriteString(&oled, 0,-1,-1,map_coord_system(packet->current_wcs), FONT_6x8, 0, 1);   
-
-          oledWriteString(&oled, 0,0,4,(char *)"                ", FONT_6x8, 0, 1);
-          oledWriteString(&oled, 0,-1,-1,(char *)"RUN  ", FONT_6x8, 0, 1); 
-
-          oledWriteString(&oled, 2,0,2,(char *)"        ", FONT_8x8, 0, 1); 
-          if(packet->machine_modes.reports_imperial == 1)
-            sprintf(charbuf, "X %8.4F", packet->coordinate.x);
-          else
-            sprintf(charbuf, "X %8.3F", packet->coordinate.x);
-          oledWriteString(&oled, 0,0,2,charbuf, FONT_8x8, 0, 1);
-          oledWriteString(&oled, 2,0,3,(char *)"        ", FONT_8x8, 0, 1); 
-          if(packet->machine_modes.reports_imperial == 1)
-            sprintf(charbuf, "Y %8.4F", packet->coordinate.y);
-          else
-            sprintf(charbuf, "Y %8.3F", packet->coordinate.y);
-          oledWriteString(&oled, 0,0,3,charbuf, FONT_8x8, 0, 1);
-          oledWriteString(&oled, 2,0,4,(char *)"        ", FONT_8x8, 0, 1); 
-          if(packet->machine_modes.reports_imperial == 1)
-            sprintf(charbuf, "Z %8.4F", packet->coordinate.z);
-          else
-            sprintf(charbuf, "Z %8.3F", packet->coordinate.z);
-          oledWriteString(&oled, 0,0,4,charbuf, FONT_8x8, 0, 1);
-          if(!isnan(packet->coordinate.a)){          
-            if(packet->machine_modes.reports_imperial == 1)
-              sprintf(charbuf, "A %8.4F", packet->coordinate.a);
-            else
-              sprintf(charbuf, "A %8.3F", packet->coordinate.a);
-            oledWriteString(&oled, 0,0,5,charbuf, FONT_8x8, 0, 1);
-          }else{
-            sprintf(charbuf, "          ", packet->coordinate.a);
-            oledWriteString(&oled, 0,0,5,charbuf, FONT_8x8, 0, 1);            
-          }         
-
-        if(packet->machine_modes.mode == Mode_Laser)
-          oledWriteString(&oled, 0,0,6,(char *)"                 PWR", FONT_6x8, 0, 1);
-        else
-          oledWriteString(&oled, 0,0,6,(char *)"                 RPM", FONT_6x8, 0, 1);         
-
-          sprintf(charbuf, "S:%3d  F:%3d    ", packet->spindle_override, packet->feed_override);
-          oledWriteString(&oled, 0,0,BOTTOMLINE,charbuf, FONT_6x8, 0, 1);
-          //this is the RPM number
-          sprintf(charbuf, "%5d", packet->spindle_rpm);
-          oledWriteString(&oled, 0,-1,-1,charbuf, FONT_6x8, 0, 1);    
-        break; //close cycle case        
+static void fmt_state(char *text){
+  switch (snap.packet.system_state){
+    case SystemState_Idle :
+      strcpy(text, " IDLE");
+      break;
+    case SystemState_Jog :
+      strcpy(text, " JOG ");
+      break;
+    case SystemState_ToolChange :
+      strcpy(text, " TOOL");
+      break;
+    default :
+      text[0] = 0;
+      break;
+  }
+}
 
-        case SystemState_Hold :
-          //can still adjust overrides during hold
-          //no jog during hold
-          oledWriteString(&oled, 0,0,INFOLINE,(char *)"    HOLDING     ", JOGFONT, 0, 1);
-          //can still adjust overrides during hold
-          oledWriteString(&oled, 0,0,2,(char *)"                G", FONT_6x8, 0, 1);
-          oledWriteString(&oled, 0,-1,-1,map_coord_system(packet->current_wcs), FONT_6x8, 0, 1);   
-
-          if(packet->machine_modes.reports_imperial == 1)
-            sprintf(charbuf, "X %8.4F", packet->coordinate.x);
-          else
-            sprintf(charbuf, "X %8.3F", packet->coordinate.x);
-          oledWriteString(&oled, 0,0,2,charbuf, FONT_8x8, 0, 1); 
-          if(packet->machine_modes.reports_imperial == 1)
-            sprintf(charbuf, "Y %8.4F", packet->coordinate.y);
-          else
-            sprintf(charbuf, "Y %8.3F", packet->coordinate.y);
-          oledWriteString(&oled, 0,0,3,charbuf, FONT_8x8, 0, 1); 
-          if(packet->machine_modes.reports_imperial == 1)
-            sprintf(charbuf, "Z %8.4F", packet->coordinate.z);
-          else
-            sprintf(charbuf, "Z %8.3F", packet->coordinate.z);
-          oledWriteString(&oled, 0,0,4,charbuf, FONT_8x8, 0, 1);
-          if(!isnan(packet->coordinate.a)){          
-            if(packet->machine_modes.reports_imperial == 1)
-              sprintf(charbuf, "A %8.4F", packet->coordinate.a);
-            else
-              sprintf(charbuf, "A %8.3F", packet->coordinate.a);
-            oledWriteString(&oled, 0,0,5,charbuf, FONT_8x8, 0, 1);
-          }else{
-            sprintf(charbuf, "          ", packet->coordinate.a);
-            oledWriteString(&oled, 0,0,5,charbuf, FONT_8x8, 0, 1);            
-          }           
-
-        if(packet->machine_modes.mode == Mode_Laser)
-          oledWriteString(&oled, 0,0,6,(char *)"                 PWR", FONT_6x8, 0, 1);
-        else
-          oledWriteString(&oled, 0,0,6,(char *)"                 RPM", FONT_6x8, 0, 1);           
-
-          sprintf(charbuf, "S:%3d  F:%3d    ", packet->spindle_override, packet->feed_override);
-          oledWriteString(&oled, 0,0,BOTTOMLINE,charbuf, FONT_6x8, 0, 1);
-          //this is the RPM number
-          sprintf(charbuf, "%5d", packet->spindle_rpm);
-          oledWriteString(&oled, 0,-1,-1,charbuf, FONT_6x8, 0, 1);                
-        break; //close hold case
+static void fmt_spindle_label(char *text){
+  strcpy(text, snap.packet.machine_modes.mode == Mode_Laser ? "PWR" : "RPM");
+}
 
-        case SystemState_ToolChange :
-          //dream feature is to put tool info/comment/number on screen during tool change.
-          //cannot adjust overrides during tool change
-          //jogging allowed during tool change
-          sprintf(charbuf, "        : %3.3f ", packet->jog_stepsize * (packet->machine_modes.reports_imperial ? 0.03937f : 1.0f));
-          oledWriteString(&oled, 0,0,INFOLINE,charbuf, INFOFONT, 0, 1);
-          switch (packet->jog_mode.mode) {
-            case FAST :
-            case SLOW : 
-              oledWriteString(&oled, 0,0,INFOLINE,(char *)"JOG FEED", INFOFONT, 0, 1); 
-              break;
-            case STEP : 
-              oledWriteString(&oled, 0,0,INFOLINE,(char *)"JOG STEP", INFOFONT, 0, 1);
-              break;
-            default :
-            break; 
-              }//close jog states
-          oledWriteString(&oled, 0,0,2,(char *)"                G", FONT_6x8, 0, 1);
-          oledWriteString(&oled, 0,-1,-1,map_coord_system(packet->current_wcs), FONT_6x8, 0, 1);             
-
-          if(packet->machine_modes.reports_imperial == 1)
-            sprintf(charbuf, "X %8.4F", packet->coordinate.x);
-          else
-            sprintf(charbuf, "X %8.3F", packet->coordinate.x);
-          oledWriteString(&oled, 0,0,2,charbuf, FONT_8x8, 0, 1); 
-          if(packet->machine_modes.reports_imperial == 1)
-            sprintf(charbuf, "Y %8.4F", packet->coordinate.y);
-          else
-            sprintf(charbuf, "Y %8.3F", packet->coordinate.y);
-          oledWriteString(&oled, 0,0,3,charbuf, FONT_8x8, 0, 1); 
-          if(packet->machine_modes.reports_imperial == 1)
-            sprintf(charbuf, "Z %8.4F", packet->coordinate.z);
-          else
-            sprintf(charbuf, "Z %8.3F", packet->coordinate.z);
-          oledWriteString(&oled, 0,0,4,charbuf, FONT_8x8, 0, 1);         
-          if(!isnan(packet->coordinate.a)){          
-            if(packet->machine_modes.reports_imperial == 1)
-              sprintf(charbuf, "A %8.4F", packet->coordinate.a);
-            else
-              sprintf(charbuf, "A %8.3F", packet->coordinate.a);
-            oledWriteString(&oled, 0,0,5,charbuf, FONT_8x8, 0, 1);
-          }else{
-            sprintf(charbuf, "          ", packet->coordinate.a);
-            oledWriteString(&oled, 0,0,5,charbuf, FONT_8x8, 0, 1);            
-          }
-          oledWriteString(&oled, 0,0,BOTTOMLINE,(char *)" TOOL CHANGE", INFOFONT, 0, 1);
-        break; //close tool case
+static void fmt_overrides(char *text){
+  snprintf(text, WIDGET_TEXT_MAX + 1, "S:%3d  F:%3d", snap.packet.spindle_override, snap.packet.feed_override);
+}
 
-        case SystemState_Homing :
-          //no overrides during homing
-          if( (prev_packet.system_state != packet->system_state) )
-          oledFill(&oled, 0,1);
-          oledWriteString(&oled, 0,0,0,(char *)" *****************", FONT_6x8, 0, 1);
-          oledWriteString(&oled, 0,0,7,(char *)" *****************", FONT_6x8, 0, 1);
-          //no jog during hold
-          oledWriteString(&oled, 0,0,4,(char *)"HOMING", JOGFONT, 0, 1);
-        break; //close home case
+static void fmt_rpm(char *text){
+  snprintf(text, WIDGET_TEXT_MAX + 1, "%5d", snap.packet.spindle_rpm);
+}
+
+static void fmt_alarm_code(char *text){
+  snprintf(text, WIDGET_TEXT_MAX + 1, "Code: %d", snap.packet.system_substate);
+}
+
+// blink on the clock, the idle refresh redraws the screen every status period
+static bool blink_on(void){ return (time_us_32() / 1000000) & 1; }
+static void fmt_blink_stars(char *text){ strcpy(text, blink_on() ? STARS : ""); }
+static void fmt_blink_no_connection(char *text){ strcpy(text, blink_on() ? "NO CONNECTION" : ""); }
+
+// Screen layouts, one table per machine state. Boxes: x, page, font, width in characters.
+#define AXIS_WIDGETS \
+  {0, 2, FONT_8x8, 12, NULL, fmt_x}, \
+  {0, 3, FONT_8x8, 12, NULL, fmt_y}, \
+  {0, 4, FONT_8x8, 12, NULL, fmt_z}, \
+  {0, 5, FONT_8x8, 12, NULL, fmt_a}
+#define SPINDLE_WIDGETS \
+  {102, 6, FONT_6x8, 3, NULL, fmt_spindle_label}, \
+  {0, BOTTOMLINE, FONT_6x8, 16, NULL, fmt_overrides}, \
+  {96, BOTTOMLINE, FONT_6x8, 5, NULL, fmt_rpm}
+
+static const widget_t idle_layout[] = { // jogging is allowed
+  {0, INFOLINE, INFOFONT, 16, NULL, fmt_jog_info},
+  {96, 2, FONT_6x8, 5, NULL, fmt_wcs},
+  {94, 4, FONT_6x8, 5, NULL, fmt_state},
+  AXIS_WIDGETS,
+  SPINDLE_WIDGETS,
+};
+
+static const widget_t jog_layout[] = { // the jogged axis in FONT_12x16 across the screen
+  {0, INFOLINE, INFOFONT, 16, NULL, fmt_jog_info},
+  {0, 3, FONT_8x8, 1, NULL, fmt_jog_letter}, // on the baseline of the number
+  {16, 2, FONT_12x16, 8, NULL, fmt_jog_value},
+  {0, 4, FONT_8x8, 12, NULL, fmt_jog_axis1},
+  {0, 5, FONT_8x8, 12, NULL, fmt_jog_axis2},
+  {0, 6, FONT_8x8, 12, NULL, fmt_jog_axis3},
+  {96, 4, FONT_6x8, 5, NULL, fmt_wcs},
+  {94, 5, FONT_6x8, 5, NULL, fmt_state},
+  SPINDLE_WIDGETS,
+};
+
+static const widget_t cycle_layout[] = { // no jog, overrides still work, show the feed rate
+  {0, INFOLINE, INFOFONT, 16, NULL, fmt_feed_info},
+  {96, 2, FONT_6x8, 5, NULL, fmt_wcs},
+  {96, 4, FONT_6x8, 5, "RUN", NULL},
+  AXIS_WIDGETS,
+  SPINDLE_WIDGETS,
+};
+
+static const widget_t hold_layout[] = { // no jog, overrides still work
+  {0, INFOLINE, JOGFONT, 16, "    HOLDING", NULL},
+  {96, 2, FONT_6x8, 5, NULL, fmt_wcs},
+  AXIS_WIDGETS,
+  SPINDLE_WIDGETS,
+};
+
+static const widget_t toolchange_layout[] = { // jogging allowed, no overrides
+  {0, INFOLINE, INFOFONT, 16, NULL, fmt_jog_info},
+  {96, 2, FONT_6x8, 5, NULL, fmt_wcs},
+  AXIS_WIDGETS,
+  {0, BOTTOMLINE, INFOFONT, 12, " TOOL CHANGE", NULL},
+};
+
+static const widget_t homing_layout[] = {
+  {0, 0, FONT_6x8, 18, STARS, NULL},
+  {0, 7, FONT_6x8, 18, STARS, NULL},
+  {0, 4, JOGFONT, 6, "HOMING", NULL},
+};
+
+static const widget_t alarm_layout[] = {
+  {0, 0, FONT_6x8, 18, STARS, NULL},
+  {0, 7, FONT_6x8, 18, STARS, NULL},
+  {0, 3, JOGFONT, 5, "ALARM", NULL},
+  {0, 4, INFOFONT, 10, NULL, fmt_alarm_code},
+};
+
+static const widget_t reset_layout[] = {
+  {0, 0, FONT_6x8, 18, STARS, NULL},
+  {0, 7, FONT_6x8, 18, STARS, NULL},
+  {0, 3, JOGFONT, 9, "RESETTING", NULL},
+  {0, 4, INFOFONT, 10, "CONTROLLER", NULL},
+};
+
+static const widget_t no_connection_layout[] = {
+  {0, 0, FONT_6x8, 18, NULL, fmt_blink_stars},
+  {0, 7, FONT_6x8, 18, NULL, fmt_blink_stars},
+  {0, 4, JOGFONT, 13, NULL, fmt_blink_no_connection},
+};
+
+// Info pages, next to the machine state screen (page 0). Shift + feed override
+// reset steps forward through them, shift + spindle override reset back.
+#define PAGE_VALUE_X 48 // values right of the labels, 13 characters of FONT_6x8 to the edge
+
+static const char *const state_names[] = {
+  "Idle", "Alarm", "Check", "Homing", "Cycle", "Hold", "Jog", "Door open", "Sleep", "E-stop", "Tool change"
+};
+static const char *const alarm_names[Alarm_AlarmMax + 1] = {
+  "", "Hard limit", "Soft limit", "Abort cycle", "Probe fail", "Probe contact", "Homing reset", "Homing door",
+  "Pulloff fail", "Approach fail", "E-stop", "Homing needed", "Limits active", "Probe protect", "Spindle",
+  "Autosquare", "Selftest fail", "Motor fault"
+};
+
+// work offsets, from the last MachineMsg_WorkOffset message (msg[] holds the
+// offsets like machine_coords_t)
+static machine_coords_t work_offset;
+static bool work_offset_known = false;
 
+static void page_title(const char *title, const asset_bitmap_t *icon){
+  display_rect(0, 0, display_width() - 1, 7, true, true);
+  asset_draw(icon, 2, 0, true);
+  display_text((display_width() - (int)strlen(title) * 6) / 2, 0, title, FONT_6x8, true);
+}
+
+static void page_labels(const char *const *labels, int count){
+  for (int i = 0; i < count; i++)
+    display_text(0, 2 + i, labels[i], FONT_6x8, false);
+}
+
+static bool snap_alarm(void){ return snap.packet.system_state == SystemState_Alarm; }
+static void fmt_state_name(char *text){
+  if (snap.packet.status_code == Status_UserException)
+    strcpy(text, "No link");
+  else if (snap.packet.system_state < sizeof(state_names) / sizeof(state_names[0]))
+    strcpy(text, state_names[snap.packet.system_state]);
+  else
+    snprintf(text, WIDGET_TEXT_MAX + 1, "%d", snap.packet.system_state);
+}
+static void fmt_alarm(char *text){
+  if (snap_alarm())
+    snprintf(text, WIDGET_TEXT_MAX + 1, "%d", snap.packet.system_substate);
+  else
+    strcpy(text, "-");
+}
+static void fmt_alarm_name(char *text){
+  strcpy(text, snap_alarm() && snap.packet.system_substate <= Alarm_AlarmMax ? alarm_names[snap.packet.system_substate] : "");
+}
+static void fmt_status(char *text){ snprintf(text, WIDGET_TEXT_MAX + 1, "%d", snap.packet.status_code); }
+static void fmt_limits(char *text){
+  static const char axes[] = "XYZABCUV";
+  int n = 0;
+
+  for (int i = 0; i < 8; i++)
+    if (snap.packet.limits.mask & (1 << i))
+      text[n++] = axes[i];
+  strcpy(&text[n], n ? "" : "-");
+}
+static void fmt_homed(char *text){
+  strcpy(text, snap.packet.machine_modes.homed ? "yes" : "no");
+  if (snap.packet.machine_modes.tlo_referenced)
+    strcat(text, ", TLO");
+}
+
+static void machine_chrome(void){
+  static const char *const labels[] = {"State", "Alarm", "", "Status", "Limits", "Homed"};
+
+  page_title("MACHINE", &icon_machine);
+  page_labels(labels, sizeof(labels) / sizeof(labels[0]));
+}
+static const widget_t machine_page[] = {
+  {PAGE_VALUE_X, 2, FONT_6x8, 13, NULL, fmt_state_name},
+  {PAGE_VALUE_X, 3, FONT_6x8, 13, NULL, fmt_alarm},
+  {PAGE_VALUE_X, 4, FONT_6x8, 13, NULL, fmt_alarm_name},
+  {PAGE_VALUE_X, 5, FONT_6x8, 13, NULL, fmt_status},
+  {PAGE_VALUE_X, 6, FONT_6x8, 13, NULL, fmt_limits},
+  {PAGE_VALUE_X, 7, FONT_6x8, 13, NULL, fmt_homed},
+};
+
+static void fmt_page_axis(char *text, float value){
+  text[0] = 0;
+  if (!isnan(value))
+    dro_format(text, value, 9, dro_decimals(snap.packet.machine_modes.reports_imperial == 1));
+}
+static void fmt_work_x(char *text){ fmt_page_axis(text, snap.packet.coordinate.x); }
+static void fmt_work_y(char *text){ fmt_page_axis(text, snap.packet.coordinate.y); }
+static void fmt_work_z(char *text){ fmt_page_axis(text, snap.packet.coordinate.z); }
+static void fmt_work_a(char *text){ fmt_page_axis(text, snap.packet.coordinate.a); }
+static void fmt_offset(char *text, int axis){
+  text[0] = 0;
+  if (work_offset_known)
+    fmt_page_axis(text, work_offset.values[axis]);
+}
+static void fmt_offset_x(char *text){ fmt_offset(text, 0); }
+static void fmt_offset_y(char *text){ fmt_offset(text, 1); }
+static void fmt_offset_z(char *text){ fmt_offset(text, 2); }
+static void fmt_offset_a(char *text){ fmt_offset(text, 3); }
+static void fmt_units(char *text){
+  snprintf(text, WIDGET_TEXT_MAX + 1, "Units %s, %s", snap.packet.machine_modes.reports_imperial ? "inch" : "mm",
+           snap.packet.machine_modes.imperial ? "G20" : "G21");
+}
+
+static void position_chrome(void){
+  static const char *const labels[] = {"", "X", "Y", "Z", "A"};
+
+  page_title("POSITION", &icon_position);
+  page_labels(labels, sizeof(labels) / sizeof(labels[0]));
+  display_text(42, 2, "WORK", FONT_6x8, false);
+  display_text(90, 2, "OFFSET", FONT_6x8, false);
+}
+static const widget_t position_page[] = {
+  {0, 2, FONT_6x8, 5, NULL, fmt_wcs},
+  {12, 3, FONT_6x8, 9, NULL, fmt_work_x},
+  {12, 4, FONT_6x8, 9, NULL, fmt_work_y},
+  {12, 5, FONT_6x8, 9, NULL, fmt_work_z},
+  {12, 6, FONT_6x8, 9, NULL, fmt_work_a},
+  {72, 3, FONT_6x8, 9, NULL, fmt_offset_x},
+  {72, 4, FONT_6x8, 9, NULL, fmt_offset_y},
+  {72, 5, FONT_6x8, 9, NULL, fmt_offset_z},
+  {72, 6, FONT_6x8, 9, NULL, fmt_offset_a},
+  {0, 7, FONT_6x8, 21, NULL, fmt_units},
+};
+
+static void fmt_feed_override(char *text){ snprintf(text, WIDGET_TEXT_MAX + 1, "%3d%%", snap.packet.feed_override); }
+static void fmt_spindle_override(char *text){ snprintf(text, WIDGET_TEXT_MAX + 1, "%3d%%", snap.packet.spindle_override); }
+static void fmt_feed_rate(char *text){ dro_format(text, snap.packet.feed_rate, 8, 1); }
+static void fmt_spindle_rpm(char *text){ snprintf(text, WIDGET_TEXT_MAX + 1, "%8d", snap.packet.spindle_rpm); }
+static void fmt_spindle_state(char *text){
+  if (!snap.packet.spindle_state.on)
+    strcpy(text, "off");
+  else
+    snprintf(text, WIDGET_TEXT_MAX + 1, "%s%s", snap.packet.spindle_state.ccw ? "CCW" : "CW",
+             snap.packet.spindle_state.at_speed ? ", at speed" : "");
+}
+static void fmt_coolant(char *text){
+  if (!snap.packet.coolant_state.flood && !snap.packet.coolant_state.mist)
+    strcpy(text, "off");
+  else
+    snprintf(text, WIDGET_TEXT_MAX + 1, "%s%s", snap.packet.coolant_state.flood ? "flood " : "",
+             snap.packet.coolant_state.mist ? "mist" : "");
+}
+static void fmt_machine_mode(char *text){
+  static const char *const modes[] = {"Standard", "Laser", "Lathe", "?"};
+
+  strcpy(text, modes[snap.packet.machine_modes.mode]);
+}
+
+static void overrides_chrome(void){
+  static const char *const labels[] = {"Feed", "Spindle", "Spins", "Coolant", "Mode"};
+
+  page_title("OVERRIDES", &icon_overrides);
+  page_labels(labels, sizeof(labels) / sizeof(labels[0]));
+}
+static const widget_t overrides_page[] = {
+  {PAGE_VALUE_X, 2, FONT_6x8, 4, NULL, fmt_feed_override},
+  {78, 2, FONT_6x8, 8, NULL, fmt_feed_rate},
+  {PAGE_VALUE_X, 3, FONT_6x8, 4, NULL, fmt_spindle_override},
+  {78, 3, FONT_6x8, 8, NULL, fmt_spindle_rpm},
+  {PAGE_VALUE_X, 4, FONT_6x8, 13, NULL, fmt_spindle_state},
+  {PAGE_VALUE_X, 5, FONT_6x8, 13, NULL, fmt_coolant},
+  {PAGE_VALUE_X, 6, FONT_6x8, 13, NULL, fmt_machine_mode},
+};
+
+static void fmt_link_packets(char *text){ snprintf(text, WIDGET_TEXT_MAX + 1, "%lu", (unsigned long)snap.link_packets); }
+static void fmt_link_sent(char *text){ snprintf(text, WIDGET_TEXT_MAX + 1, "%lu", (unsigned long)snap.link_sent); }
+static void fmt_link_errors(char *text){ snprintf(text, WIDGET_TEXT_MAX + 1, "%lu", (unsigned long)snap.link_errors); }
+static void fmt_oled_frames(char *text){ snprintf(text, WIDGET_TEXT_MAX + 1, "%lu", (unsigned long)oled_frames); }
+static void fmt_oled_bytes(char *text){ snprintf(text, WIDGET_TEXT_MAX + 1, "%lu", (unsigned long)oled_frame_bytes); }
+static void fmt_redraws_avoided(char *text){ snprintf(text, WIDGET_TEXT_MAX + 1, "%lu", (unsigned long)ui_redraws_avoided); }
+
+static void link_chrome(void){
+  static const char *const labels[] = {"Packets", "Sent", "Errors", "Frames", "Bytes", "Skipped"};
+
+  page_title("LINK", &icon_link);
+  page_labels(labels, sizeof(labels) / sizeof(labels[0]));
+}
+static const widget_t link_page[] = {
+  {PAGE_VALUE_X, 2, FONT_6x8, 13, NULL, fmt_link_packets},
+  {PAGE_VALUE_X, 3, FONT_6x8, 13, NULL, fmt_link_sent},
+  {PAGE_VALUE_X, 4, FONT_6x8, 13, NULL, fmt_link_errors},
+  {PAGE_VALUE_X, 5, FONT_6x8, 13, NULL, fmt_oled_frames},
+  {PAGE_VALUE_X, 6, FONT_6x8, 13, NULL, fmt_oled_bytes},
+  {PAGE_VALUE_X, 7, FONT_6x8, 13, NULL, fmt_redraws_avoided},
+};
+
+#define PAGE(chrome, widgets) {chrome, widgets, sizeof(widgets) / sizeof(widgets[0])}
+static const page_t info_pages[] = {
+  PAGE(machine_chrome, machine_page),
+  PAGE(position_chrome, position_page),
+  PAGE(overrides_chrome, overrides_page),
+  PAGE(link_chrome, link_page),
+};
+#define PAGE_COUNT (1 + (int)(sizeof(info_pages) / sizeof(info_pages[0])))
+static int ui_page = 0; // 0 = the machine state screen
+
+// Starts a frame: picks the layout for the machine state, force redraws every
+// widget. render_slice() draws the changed widgets and sends them.
+static void draw_main_screen(bool force){ 
+  const widget_t *layout = NULL;
+  int count = 0;
+
+  switch (snap.screenmode){
+  case JOG_MODIFY:
+  case JOGGING: 
+  case RUN:   
+  case DEFAULT:  
+      switch (snap.packet.system_state){
+        case SystemState_Jog :
+          layout = jog_layout;
+          count = sizeof(jog_layout) / sizeof(jog_layout[0]);
+          break;
+        case SystemState_Idle :
+          layout = idle_layout;
+          count = sizeof(idle_layout) / sizeof(idle_layout[0]);
+          break;
+        case SystemState_Cycle :
+          layout = cycle_layout;
+          count = sizeof(cycle_layout) / sizeof(cycle_layout[0]);
+          break;
+        case SystemState_Hold :
+          layout = hold_layout;
+          count = sizeof(hold_layout) / sizeof(hold_layout[0]);
+          break;
+        case SystemState_ToolChange :
+          layout = toolchange_layout;
+          count = sizeof(toolchange_layout) / sizeof(toolchange_layout[0]);
+          break;
+        case SystemState_Homing :
+          layout = homing_layout;
+          count = sizeof(homing_layout) / sizeof(homing_layout[0]);
+          break;
         case SystemState_Alarm : 
-          //only re-fill the screen if the state or alarm code have changed.
-          if( (prev_packet.system_substate != packet->system_substate) || (prev_packet.system_state != packet->system_state) )
-            oledFill(&oled, 0,1);
-            prev_packet.system_substate = packet->system_substate;
-          oledWriteString(&oled, 0,0,0,(char *)" *****************", FONT_6x8, 0, 1);
-          oledWriteString(&oled, 0,0,7,(char *)" *****************", FONT_6x8, 0, 1);
-          //no jog during hold
-          oledWriteString(&oled, 0,0,3,(char *)"ALARM", JOGFONT, 0, 1);
-          sprintf(charbuf, "Code: %d ", packet->system_substate);
-          oledWriteString(&oled, 0,0,4,charbuf, INFOFONT, 0, 1);        
-        break; //close alarm case
- 
+          layout = alarm_layout;
+          count = sizeof(alarm_layout) / sizeof(alarm_layout[0]);
+          break;
         default :
-          if( (packet->status_code == Status_Reset)){
-            oledFill(&oled, 0,1);
-            oledWriteString(&oled, 0,0,0,(char *)" *****************", FONT_6x8, 0, 1);
-            oledWriteString(&oled, 0,0,7,(char *)" *****************", FONT_6x8, 0, 1);
-            //no jog during hold
-            oledWriteString(&oled, 0,0,3,(char *)"RESETTING", JOGFONT, 0, 1);
-            oledWriteString(&oled, 0,0,4,(char *)"CONTROLLER", INFOFONT, 0, 1);
-          }     
-          else if( (packet->status_code == Status_UserException)){
-            oledFill(&oled, 0,1);
-            oledWriteString(&oled, 0,0,0,(char *)" *****************", FONT_6x8, 0, 1);
-            oledWriteString(&oled, 0,0,7,(char *)" *****************", FONT_6x8, 0, 1);
-            //no jog during hold
-            oledWriteString(&oled, 0,0,4,(char *)"NO CONNECTION", JOGFONT, 0, 1);
-            sleep_ms(1000);
-            oledFill(&oled, 0,1);
+          if( (snap.packet.status_code == Status_Reset)){
+            layout = reset_layout;
+            count = sizeof(reset_layout) / sizeof(reset_layout[0]);
+          }
+          else if( (snap.packet.status_code == Status_UserException)){
+            layout = no_connection_layout;
+            count = sizeof(no_connection_layout) / sizeof(no_connection_layout[0]);
           }
-        break; //close default case
+          break;
       }//close system_state switch statement
   }//close screen mode switch statement
-  packet->system_substate = prev_packet.system_substate;
-  prev_packet = *packet;
-  // previous_jogmode = current_jogmode;
-  // previous_jogmodify = current_jogmodify;
-  previous_screenmode = screenmode;  
-}//close draw main screen
 
-bool tick_timer_callback(struct repeating_timer *t) {
-    if (onboard_led_count == 0){
-    //gpio_put(ONBOARD_LED, !gpio_get_out_level(ONBOARD_LED));                // toggle the LED
-    onboard_led_count = 20;  //thi ssets the heartbeat
-    }else{
-    onboard_led_count = onboard_led_count - 1;
+  if (ui_page > 0){ //an info page instead, its chrome comes from the cache
+    page_show(&info_pages[ui_page - 1]);
+    layout = info_pages[ui_page - 1].widgets;
+    if (force)
+      widget_invalidate();
+  }
+  else if (layout){
+    if (widget_show(layout, count) || force){ //the back buffer was cleared, or everything is redrawn
+      spark_invalidate(&feed_spark);
+      spark_invalidate(&rpm_spark);
     }
+    if (force)
+      widget_invalidate();
+  }
+  sparks_shown = layout == idle_layout || layout == cycle_layout || layout == hold_layout;
+  if (layout)
+    render_phase = RENDER_DRAW;
+  else
+    render_flush_begin();
 
-    status_update_counter = status_update_counter - 1;
-    if (status_update_counter < 0){
-      status_update_counter = 0;
-    }
+  //the packet as of the frame start, a change while it is drawn makes the next frame
+  prev_packet = snap.packet;
+  previous_screenmode = snap.screenmode;  
+}//close draw main screen
 
-    led_update_counter = led_update_counter - 1;
-    if (led_update_counter <= 0){
-        update_neopixel_leds = 1;
-        led_update_counter = LED_UPDATE_PERIOD;
+// Strobes the queued characters out to the controller, one at a time:
+// send, wait for the controller to read it, settle, then refresh.
+static int link_task(task_t *t) {
+  TASK_BEGIN(t);
+  for (;;) {
+    TASK_WAIT_UNTIL(t, link_head != link_tail);
+    link_cmd = link_queue[link_tail];
+    link_tail = (link_tail + 1) % LINK_QUEUE_SIZE;
+    link_busy = true;
+    gpio_put(ONBOARD_LED, 0);
+
+    if (link_cmd.flags & LINK_STROBE_GAP) {
+      gpio_put(KPSTR_PIN, false);
+      TASK_SLEEP_MS(t, LINK_STROBE_GAP_MS);
+    }
+    // leave the RAM alone while the controller is writing a status packet
+    TASK_WAIT_UNTIL(t, !(context.mem_address_written != false && context.mem_address > 0));
+
+    context.mem[0] = link_cmd.character;
+    context.mem_address = 0;
+    TASK_SLEEP_US(t, LINK_STROBE_SETUP_US);
+    gpio_put(KPSTR_PIN, true);
+
+    link_deadline = make_timeout_time_us(I2C_TIMEOUT_VALUE);
+    TASK_WAIT_UNTIL(t, context.mem_address != 0 || time_reached(link_deadline));
+    link_sent++;
+    if (context.mem_address == 0){
+      link_errors++;
+      mailbox_post(&render_mailbox, RENDER_EV_COMMAND_ERR);
     }
+    if (link_cmd.flags & LINK_CLEAR_STROBE)
+      gpio_put(KPSTR_PIN, false);
+    gpio_put(ONBOARD_LED, 1);
+
+    if (link_cmd.settle_ms)
+      TASK_SLEEP_MS(t, link_cmd.settle_ms);
+    if (link_cmd.flags & LINK_RESET_SCREEN)
+      mailbox_post(&render_mailbox, RENDER_EV_RESETTING);
+    if (link_cmd.flags & LINK_REFRESH_LEDS)
+      update_neopixels();
+    link_busy = false;
+  }
+  TASK_END(t);
+}
 
-    if(direction_pressed){
-      rollover_delay++;
-      if(rollover_delay > ROLLOVER_DELAY_PERIOD)
-        rollover_delay = ROLLOVER_DELAY_PERIOD;
+static bool screenflip_requested = false;
+static task_t screenflip_state;
 
-      transition_delay = transition_delay - 1;
-      if(transition_delay < 0)
-        transition_delay = 0;
-    }       
-    
-    return true;
+// Shifted HALT: store the inverted screen orientation in flash and reboot.
+static int screenflip_task(task_t *t) {
+  uint32_t status;
+
+  TASK_BEGIN(t);
+  TASK_WAIT_UNTIL(t, screenflip_requested);
+  pixels.setPixelColor(HALTLED,pixels.Color(255,255,0));
+  pixels.show();
+  TASK_SLEEP_MS(t, SCREENFLIP_SETTLE_MS);
+
+  //erase and write memory location based on current value of screenflip.
+  screenflip = !screenflip;
+#if RENDER_CORE1
+  multicore_lockout_start_blocking(); //core1 runs from flash as well, it stays parked until the reset
+#endif
+  status = save_and_disable_interrupts();
+  flash_range_erase(FLASH_TARGET_OFFSET, FLASH_SECTOR_SIZE);
+  restore_interrupts(status);
+  TASK_SLEEP_MS(t, SCREENFLIP_SETTLE_MS);
+
+  status = save_and_disable_interrupts();
+  flash_range_program(FLASH_TARGET_OFFSET, (uint8_t*)&screenflip, 1);
+  restore_interrupts(status);
+
+  #define AIRCR_Register (*((volatile uint32_t*)(PPB_BASE + 0x0ED0C)))
+
+  AIRCR_Register = 0x5FA0004;
+  TASK_END(t);
 }
 
-// Main loop - initilises system and then loops while interrupts get on with processing the data
+// Scheduler tasks ***********************************************************************
+// Each one runs to completion, see task_table[] for periods and budgets.
 
-/*
-red = (255, 0, 0)
-orange = (255, 165, 0)
-yellow = (255, 150, 0)
-green = (0, 255, 0)
-blue = (0, 0, 255)
-indigo = (75, 0, 130)
-violet = (138, 43, 226)
-off = (0, 0, 0)
-*/
+// Only polled while a character is in flight, an idle link waits for
+// keypad_sendchar() or the controller
+static void link_poll(void) {
+  link_task(&link_state);
+  if (!link_idle())
+    sched_trigger_in(link_poll, LINK_BUSY_PERIOD_US);
+}
 
-int main() {
+// The float fields compared as the text they show: coordinates at the DRO
+// resolution, feed and jog step at the 3 decimals of the info line. Noise
+// below the last digit, or a float that came back re-encoded, is no change.
+static bool render_shown_changed(void) {
+  int decimals = dro_decimals(snap.packet.machine_modes.reports_imperial == 1);
+  const machine_coords_t *now = &snap.packet.coordinate, *before = &previous_packet->coordinate;
+
+  for (int i = 0; i < 4; i++)
+    if (dro_quantize(now->values[i], decimals) != dro_quantize(before->values[i], decimals))
+      return true; //A is NaN on both sides without a fourth axis
+  return dro_quantize(snap.packet.feed_rate, 3) != dro_quantize(previous_packet->feed_rate, 3) ||
+         dro_quantize(jog_step_shown(&snap.packet), 3) != dro_quantize(jog_step_shown(previous_packet), 3);
+}
 
-  stdio_init_all();
+// The same fields compared as floats, only to count what the above saves
+static bool render_raw_changed(void) {
+  return memcmp(&snap.packet.coordinate, &previous_packet->coordinate, sizeof(machine_coords_t)) ||
+         snap.packet.feed_rate != previous_packet->feed_rate ||
+         snap.packet.jog_stepsize != previous_packet->jog_stepsize;
+}
 
-  gpio_init(KPSTR_PIN);
-  gpio_set_dir(KPSTR_PIN, GPIO_OUT);
+// Compare the packet with the one on screen and mark what changed
+static void render_check_packet(void) {
+  char notice[NOTIFY_TEXT_MAX + 1];
+
+  if (snap.packet.system_state == SystemState_Alarm && previous_packet->system_state != SystemState_Alarm){
+    snprintf(notice, sizeof(notice), "ALARM %d", snap.packet.system_substate);
+    notify_post(notice, NOTIFY_ALARM, ALARM_NOTICE_MS); //replaces whatever else shows
+  }
+  if (snap.packet.msgtype == MachineMsg_WorkOffset){
+    memcpy(&work_offset, snap.packet.msg, sizeof(work_offset));
+    work_offset_known = true;
+    ui_invalidate(0);
+  }
+  if (snap.packet.msgtype == MachineMsg_ClearMessage)
+    ticker_stop();
+  else if (snap.packet.msgtype >= 1 && snap.packet.msgtype <= TICKER_TEXT_MAX)
+    ticker_show((const char *)snap.packet.msg, snap.packet.msgtype);
+
+  //draw_main_screen(1);
+  
+  // if (!packet->machine_state.disconnected){
+  //   current_jogmode = (Jogmode) (packet->jog_mode.mode);
+  //   current_jogmodify =  (Jogmodify) (packet->jog_mode.modifier);
+  // }
+
+  if (snap.packet.system_state == SystemState_Jog){
+    int decimals = dro_decimals(snap.packet.machine_modes.reports_imperial == 1);
+    for (int i = 0; i < 4; i++)
+      if (dro_quantize(snap.packet.coordinate.values[i], decimals) !=
+          dro_quantize(previous_packet->coordinate.values[i], decimals))
+        jog_axis = i; //the axis on the move, large on jog_layout
+  }
+
+  if( snap.packet.system_state != previous_packet->system_state ||
+      snap.packet.system_substate != previous_packet->system_substate ||
+      snap.packet.feed_override != previous_packet->feed_override ||
+      snap.packet.spindle_override != previous_packet->spindle_override||
+      snap.packet.jog_mode.value != previous_packet->jog_mode.value ||
+      snap.packet.machine_modes.reports_imperial != previous_packet->machine_modes.reports_imperial ||
+      render_shown_changed() ||
+      snap.packet.current_wcs != previous_packet->current_wcs ||
+      snap.packet.spindle_rpm != previous_packet->spindle_rpm ||
+      snap.packet.jog_mode.modifier != previous_packet->jog_mode.modifier ||
+      snap.screenmode != previous_screenmode
+      ){          
+    ui_invalidate(0);
+  }
+  else if (render_raw_changed())
+    ui_redraws_avoided++; //the floats moved, the text on screen would not
 
-  gpio_init(HALTBUTTON);
-  gpio_set_dir(HALTBUTTON, GPIO_IN);
-  gpio_set_pulls(HALTBUTTON,true,false);
+  //if(screenmode != previous_screenmode)
+  //  draw_main_screen(1);
+}
 
-  gpio_init(UPBUTTON);
-  gpio_set_dir(UPBUTTON, GPIO_IN);
-  gpio_set_pulls(UPBUTTON,true,false);
+// Advance the frame in progress by as many units as fit in budget_us (at
+// least one), returns true when it is finished. Drawing only touches the back
+// buffer. The flush waits for the last frame to leave the bus, then queues
+// the changes in one go on the DMA buses, or one page row per unit on the
+// bit-bang bus that blocks while it sends.
+static bool render_slice(uint32_t budget_us) {
+  uint32_t start = time_us_32();
+  int bytes;
+
+  if (render_phase == RENDER_DRAW){
+    if (!widget_update_slice(budget_us))
+      return false;
+    render_flush_begin();
+    if (time_us_32() - start >= budget_us)
+      return false;
+  }
+  if (render_phase != RENDER_FLUSH)
+    return true;
+  if (!display_frame_done())
+    return false;
+  if (render_row < 0){
+    oled_frame_bytes = display_flush();
+  }
+  else {
+    do {
+      bytes = display_flush_row(render_row++);
+      if (bytes > 0)
+        oled_frame_bytes += bytes;
+      if (render_row >= display_height() / 8)
+        break;
+      if (time_us_32() - start >= budget_us)
+        return false;
+    } while (true);
+  }
+  oled_frames++;
+  oled_total_bytes += oled_frame_bytes;
+  render_phase = RENDER_IDLE;
+  return true;
+}
 
-  gpio_init(DOWNBUTTON);
-  gpio_set_dir(DOWNBUTTON, GPIO_IN);
-  gpio_set_pulls(DOWNBUTTON,true,false);
+// Take the events core0 posted and the newest snapshot, returns true if
+// there was a new one
+static bool render_receive(void) {
+  uint32_t event;
 
-  gpio_init(LEFTBUTTON);
-  gpio_set_dir(LEFTBUTTON, GPIO_IN);
-  gpio_set_pulls(LEFTBUTTON,true,false);
+  while (mailbox_take(&render_mailbox, &event)) {
+    switch (event) {
+      case RENDER_EV_REFRESH :
+        ui_invalidate(0);
+        break;
+      case RENDER_EV_COMMAND_ERR :
+        notify_post("COMMAND ERR", NOTIFY_WARN, COMMAND_ERR_MS);
+        break;
+      case RENDER_EV_RESETTING :
+        notify_post("RESETTING", NOTIFY_WARN, RESET_SCREEN_MS);
+        break;
+      case RENDER_EV_LOOP_STALL :
+        notify_post("LOOP STALL", NOTIFY_WARN, LOOP_STALL_NOTICE_MS);
+        break;
+      case RENDER_EV_PAGE_NEXT :
+      case RENDER_EV_PAGE_PREV :
+        ui_page = (ui_page + (event == RENDER_EV_PAGE_NEXT ? 1 : PAGE_COUNT - 1)) % PAGE_COUNT;
+        ui_invalidate(0);
+        ui_frame_start = time_us_32() - RENDER_FRAME_US; //no frame gap, the page comes up on this pass
+        break;
+    }
+  }
+  return mailbox_fetch(&render_mailbox, &snap, &snap_seq);
+}
 
-  gpio_init(RIGHTBUTTON);
-  gpio_set_dir(RIGHTBUTTON, GPIO_IN);
-  gpio_set_pulls(RIGHTBUTTON,true,false);
+// Mark the screen dirty when the controller reported something new, work on
+// the frame in progress and start the next one when the governor allows it
+static void render_task(void) {
+  bool fresh = render_receive();
+
+  if ((int32_t)(time_us_32() - history_next_us) >= 0){
+    history_next_us = time_us_32() + HISTORY_PERIOD_MS * 1000;
+    if (snap.packet.status_code != Status_UserException){
+      history_add(time_us_32() / 1000, snap.packet.feed_rate, snap.packet.spindle_rpm);
+      if (sparks_shown)
+        ui_invalidate(0); //the sparklines move on
+    }
+  }
+  if (render_phase == RENDER_IDLE && notify_update())
+    ui_invalidate(0); //a notification came or went, never in the middle of a frame
+  if (render_phase == RENDER_IDLE && ticker_update(notify_showing()))
+    ui_dirty = true; //the ticker row only, see ticker_flush()
+  if (fresh || snap.screenmode != previous_screenmode)
+    render_check_packet();
+  if (render_phase != RENDER_IDLE && !render_slice(RENDER_SLICE_US))
+    return; //more of this frame on the next pass
+  if (!ui_dirty || time_us_32() - ui_frame_start < RENDER_FRAME_US)
+    return; //nothing new, or the last frame was too recent
+  ui_frame_start = time_us_32();
+  ui_dirty = false;
+  render_content = ui_content;
+  ui_content = false;
+  draw_main_screen(ui_force);
+  ui_force = false;
+}
 
-  gpio_init(LOWERBUTTON);
-  gpio_set_dir(LOWERBUTTON, GPIO_IN);
-  gpio_set_pulls(LOWERBUTTON,true,false);
+// Hands the packet to the render side when the controller wrote a new one or
+// the screen mode changed, and keeps the LEDs up with a jog
+static void publish_task(void) {
+  static ScreenMode published_mode = DEFAULT;
+  static uint32_t leds_start = 0;
+  render_snapshot_t next;
+
+  if (context.mem_address_written)
+    return; //a write is coming in, its FINISH triggers the next try
+  if (packet_event || screenmode != published_mode){
+    packet_event = false;
+    next.packet = *packet;
+    next.screenmode = screenmode;
+    next.link_packets = link_packets;
+    next.link_sent = link_sent;
+    next.link_errors = link_errors;
+    if (context.mem_address_written || packet_event){
+      packet_event = true; //the controller wrote while it was copied, again on the next pass
+      return;
+    }
+    published_mode = screenmode;
+    mailbox_publish(&render_mailbox, &next);
+#if !RENDER_CORE1
+    sched_trigger(render_task);
+#endif
+  }
+  if (packet->system_state == SystemState_Jog && time_us_32() - leds_start >= RENDER_FRAME_US){
+    leds_start = time_us_32();
+    update_neopixels();
+  }
+}
 
-  gpio_init(RAISEBUTTON);
-  gpio_set_dir(RAISEBUTTON, GPIO_IN);
-  gpio_set_pulls(RAISEBUTTON,true,false);
+// Button scanner, plus the shifted and release-to-fire functions
+static void input_task(void) {
+  static uint8_t quiet_scans = 0;
 
-  gpio_init(JOG_SELECT);
-  gpio_set_dir(JOG_SELECT, GPIO_IN);
-  gpio_set_pulls(JOG_SELECT,true,false);
+  //once everything is released and the release actions have run, only an edge needs a rescan
+  if (!input_event && quiet_scans >= 2)
+    return;
+  input_event = false;
+  //BUTTON READING ***********************************************************************
+  //one snapshot of all button GPIOs per pass, tested with the profile's pin masks
+  uint32_t inputs = gpio_get_all() & BOARD_INPUT_MASK;
+  buttons_idle = false;
+  if (!BUTTON_DOWN(inputs, HOLDBUTTON))
+    hold_latched = false;
+  if (!BUTTON_DOWN(inputs, RUNBUTTON))
+    run_latched = false;
+
+  if(BUTTON_DOWN(inputs, HALTBUTTON)){
+    pixels.setPixelColor(HALTLED,pixels.Color(0, 0, 0));        
+    key_character = 0x18;
+    //while(BUTTON_DOWN(inputs, HALTBUTTON))
+    //  sleep_ms(250);     
+  } else if (BUTTON_DOWN(inputs, HOLDBUTTON)){
+    pixels.setPixelColor(HOLDLED,pixels.Color(0, 0, 0));
+    if(!jog_toggle_pressed && !hold_latched){
+    key_character = CMD_FEED_HOLD ;
+    keypad_sendchar(key_character, LINK_CLEAR_STROBE, 0);
+    hold_latched = true; //send once per press
+    } 
+    //gpio_put(KPSTR_PIN, false);
+                          
+  } else if (BUTTON_DOWN(inputs, RUNBUTTON)){
+    pixels.setPixelColor(RUNLED,pixels.Color(0, 0, 0));
+    if(!jog_toggle_pressed && !run_latched){
+    key_character = CMD_CYCLE_START ;
+    keypad_sendchar(key_character, LINK_CLEAR_STROBE, 0);
+    run_latched = true; //send once per press
+    }
+    //gpio_put(KPSTR_PIN, false);    
+  //misc commands.  These activate on lift
+  } else if (BUTTON_DOWN(inputs, SPINOVER_UP)){  
+    if(!jog_toggle_pressed){    
+      spin_up_pressed = 1;
+    }            
+  } else if (BUTTON_DOWN(inputs, SPINOVER_DOWN)){
+    if(!jog_toggle_pressed){    
+      spin_down_pressed = 1;
+    }
+  } else if (BUTTON_DOWN(inputs, SPINOVER_RESET)){  
+    if(!jog_toggle_pressed){
+      spin_reset_pressed = 1;
+    }
+  } else if (BUTTON_DOWN(inputs, FEEDOVER_UP)){
+    if(!jog_toggle_pressed){    
+      feed_up_pressed = 1;
+    }    
+  } else if (BUTTON_DOWN(inputs, FEEDOVER_DOWN)){
+    if(!jog_toggle_pressed){     
+      feed_down_pressed = 1;
+    }            
+  } else if (BUTTON_DOWN(inputs, FEEDOVER_RESET)){  
+    if(!jog_toggle_pressed){
+      feed_reset_pressed = 1;
+    }
+  } else if (BUTTON_DOWN(inputs, HOMEBUTTON)){  
+    home_pressed = 1;        
+  } else if (BUTTON_DOWN(inputs, MISTBUTTON)){  
+    mist_pressed = 1;
+  } else if (BUTTON_DOWN(inputs, FLOODBUTTON)){  
+    flood_pressed = 1;   
+  } else if (BUTTON_DOWN(inputs, SPINDLEBUTTON)){ 
+    spinoff_pressed = 1;
+  } else if (BUTTON_DOWN(inputs, JOG_SELECT) && (!joggle_reset)){  //Toggle Jog modes
+    jog_toggle_pressed = 1;
+  } else if (!jog_toggle_pressed &&//only read jog actions when jog toggle is released.
+             BUTTON_DOWN(inputs, UPBUTTON) ||
+             BUTTON_DOWN(inputs, RIGHTBUTTON) ||
+             BUTTON_DOWN(inputs, DOWNBUTTON) ||
+             BUTTON_DOWN(inputs, LEFTBUTTON) ||
+             BUTTON_DOWN(inputs, RAISEBUTTON) ||
+             BUTTON_DOWN(inputs, LOWERBUTTON) ){
+    activate_jogled();
+    direction_pressed = 0;           
+    direction_pressed = direction_pressed | BUTTON_DOWN(inputs, UPBUTTON) << UP;
+    direction_pressed = direction_pressed | BUTTON_DOWN(inputs, RIGHTBUTTON) << RIGHT;
+    direction_pressed = direction_pressed | BUTTON_DOWN(inputs, DOWNBUTTON) << DOWN;
+    direction_pressed = direction_pressed | BUTTON_DOWN(inputs, LEFTBUTTON) << LEFT;
+    direction_pressed = direction_pressed | BUTTON_DOWN(inputs, RAISEBUTTON) << RAISE;
+    direction_pressed = direction_pressed | BUTTON_DOWN(inputs, LOWERBUTTON) << LOWER;
+  } else {
+      if(direction_pressed){
+        direction_pressed = 0;
+        rollover_delay = 0;
+      }
+      joggle_reset = false;       
+      link_release_strobe(); //make sure stobe is clear when no button is pressed.
+      buttons_idle = true; //house_task() refreshes the screen while idle
+  }        
+
+    //close button reads
 
-  gpio_init(FEEDOVER_UP);
-  gpio_set_dir(FEEDOVER_UP, GPIO_IN);
-  gpio_set_pulls(FEEDOVER_UP,true,false);
-  
-  gpio_init(FEEDOVER_DOWN);
-  gpio_set_dir(FEEDOVER_DOWN, GPIO_IN);
-  gpio_set_pulls(FEEDOVER_DOWN,true,false);
+//SINGLE BUTTON PRESSES ***********************************************************************
+//Alternate functions ***********************************************************************
+  if (jog_toggle_pressed){  //Pure modifier button.          
+    if (BUTTON_DOWN(inputs, JOG_SELECT)){//keyis still helddown, check alternate keys.
+      screenmode = JOG_MODIFY;
+      update_neopixels();
+      //draw_main_screen(1);
+      if (BUTTON_DOWN(inputs, FLOODBUTTON)){
+        jog_mod_pressed = 1;
+      }
+      if (BUTTON_DOWN(inputs, MISTBUTTON)){
+        jog_mode_pressed = 1;
+      }
+      if (BUTTON_DOWN(inputs, LEFTBUTTON)){
+        macro_left_pressed = 1;
+      } 
+      if (BUTTON_DOWN(inputs, RIGHTBUTTON)){
+        macro_right_pressed = 1;
+      } 
+      if (BUTTON_DOWN(inputs, UPBUTTON)){
+        macro_top_pressed = 1;
+      } 
+      if (BUTTON_DOWN(inputs, DOWNBUTTON)){
+        macro_bot_pressed = 1;
+      } 
+      if (BUTTON_DOWN(inputs, RAISEBUTTON)){
+        macro_raise_pressed = 1;
+      } 
+      if (BUTTON_DOWN(inputs, LOWERBUTTON)){
+        macro_lower_pressed = 1;
+      }
+      if (BUTTON_DOWN(inputs, HOMEBUTTON)){
+        macro_home_pressed = 1;
+      }  
+      if (BUTTON_DOWN(inputs, SPINDLEBUTTON)){
+        macro_spindle_pressed = 1;
+      }  
+      if (BUTTON_DOWN(inputs, HOLDBUTTON)){
+        reset_pressed = 1;
+      }  
+      if (BUTTON_DOWN(inputs, RUNBUTTON)){
+        unlock_pressed = 1;
+      }
+      if (BUTTON_DOWN(inputs, HALTBUTTON)){
+        halt_pressed = 1;              
+      }
+      if (BUTTON_DOWN(inputs, SPINOVER_UP)){  
+        spin_up_fine_pressed = 1;            
+      }
+      if (BUTTON_DOWN(inputs, SPINOVER_DOWN)){  
+        spin_down_fine_pressed = 1;
+      }
+      if (BUTTON_DOWN(inputs, FEEDOVER_UP)){ 
+        feed_up_fine_pressed = 1;    
+      }
+      if (BUTTON_DOWN(inputs, FEEDOVER_DOWN)){ 
+        feed_down_fine_pressed = 1;            
+      }
+      if (BUTTON_DOWN(inputs, FEEDOVER_RESET)){ 
+        page_next_pressed = 1;
+      }
+      if (BUTTON_DOWN(inputs, SPINOVER_RESET)){ 
+        page_prev_pressed = 1;
+      }                                                                                                                    
+    }//close jog toggle pressed.
+  }//close jog button pressed statement
+//Single functions ***********************************************************************
+  if (jog_toggle_pressed) {
+    if (BUTTON_DOWN(inputs, JOG_SELECT)){}//button is still pressed, do nothing
+    else{
+      jog_toggle_pressed = 0;
+      screenmode = DEFAULT;
+      update_neopixels();                         
+    }
+  }
+  if (feed_down_pressed) {
+    if (BUTTON_DOWN(inputs, FEEDOVER_DOWN)){}//button is still pressed, do nothing
+    else{
+      key_character = CMD_OVERRIDE_FEED_COARSE_MINUS;
+      keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, 0);
+      feed_down_pressed = 0;
+    }
+  }
+  if (feed_up_pressed) {
+    if (BUTTON_DOWN(inputs, FEEDOVER_UP)){}//button is still pressed, do nothing
+    else{
+      key_character = CMD_OVERRIDE_FEED_COARSE_PLUS;
+      keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, 0);
+      feed_up_pressed = 0;
+    }
+  }
+  if (feed_reset_pressed) {
+    if (BUTTON_DOWN(inputs, FEEDOVER_RESET)){}//button is still pressed, do nothing
+    else{
+      key_character = CMD_OVERRIDE_FEED_RESET;
+      keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, 0);
+      feed_reset_pressed = 0;
+    }
+  }
+  if (spin_down_pressed) {
+    if (BUTTON_DOWN(inputs, SPINOVER_DOWN)){}//button is still pressed, do nothing
+    else{
+      key_character = CMD_OVERRIDE_SPINDLE_COARSE_MINUS;
+      keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, 0);
+      spin_down_pressed = 0;
+    }
+  }
+  if (spin_up_pressed) {
+    if (BUTTON_DOWN(inputs, SPINOVER_UP)){}//button is still pressed, do nothing
+    else{
+      key_character = CMD_OVERRIDE_SPINDLE_COARSE_PLUS;
+      keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, 0);
+      spin_up_pressed = 0;
+    }
+  }
+  if (spin_reset_pressed) {
+    if (BUTTON_DOWN(inputs, SPINOVER_RESET)){}//button is still pressed, do nothing
+    else{
+      key_character = CMD_OVERRIDE_SPINDLE_RESET;
+      keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, 0);
+      spin_reset_pressed = 0;
+    }
+  }
+  if (mist_pressed) {
+    if (BUTTON_DOWN(inputs, MISTBUTTON)){}//button is still pressed, do nothing
+    else{
+      if(!jog_toggle_pressed){
+      key_character = CMD_OVERRIDE_COOLANT_MIST_TOGGLE;
+      keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, 0);
+      }
+      mist_pressed = 0;
+    }
+  }
+  if (flood_pressed) {
+    if (BUTTON_DOWN(inputs, FLOODBUTTON)){}//button is still pressed, do nothing
+    else{
+      if(!jog_toggle_pressed){
+      key_character = CMD_OVERRIDE_COOLANT_FLOOD_TOGGLE;
+      keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, 0);
+      }
+      flood_pressed = 0;
+    }                    
+  }
+  if (spinoff_pressed) {
+    if (BUTTON_DOWN(inputs, SPINDLEBUTTON)){}//button is still pressed, do nothing
+    else{
+      if(!jog_toggle_pressed){
+      key_character = CMD_OVERRIDE_SPINDLE_STOP;
+      keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, 0);
+      }
+      spinoff_pressed = 0;
+    }                    
+  } 
+  if (home_pressed) {
+    if (BUTTON_DOWN(inputs, HOMEBUTTON)){}//button is still pressed, do nothing
+    else{
+      if(!jog_toggle_pressed){
+      key_character = 'H';         
+      keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, 0);
+    }
+      home_pressed = 0;
+    }                    
+  }
+  if (jog_mod_pressed) {
+    if (BUTTON_DOWN(inputs, FLOODBUTTON)){}//button is still pressed, do nothing
+    else{
+      key_character = JOGMODIFY_CYCLE;
+      keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, MACRO_SETTLE_MS);
+      jog_mod_pressed = 0;
+    }
+  }
+  if (jog_mode_pressed) {
+    if (BUTTON_DOWN(inputs, MISTBUTTON)){}//button is still pressed, do nothing
+    else{
+      key_character = JOGMODE_CYCLE;     
+      keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, MACRO_SETTLE_MS);
+      jog_mode_pressed = 0;
+    }
+  }
+  if (macro_left_pressed){
+    if (BUTTON_DOWN(inputs, LEFTBUTTON)){}//button is still pressed, do nothing
+    else{
+      key_character = MACROLEFT;
+      keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, MACRO_SETTLE_MS);
+      macro_left_pressed = 0;
+  }}
+  if (macro_right_pressed){
+    if (BUTTON_DOWN(inputs, RIGHTBUTTON)){}//button is still pressed, do nothing
+    else{
+      key_character = MACRORIGHT;
+      keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, MACRO_SETTLE_MS);
+      macro_right_pressed = 0;
+  }}
+  if (macro_top_pressed){
+    if (BUTTON_DOWN(inputs, UPBUTTON)){}//button is still pressed, do nothing
+    else{
+      key_character = MACROUP;
+      keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, MACRO_SETTLE_MS);
+      macro_top_pressed = 0;
+  }}
+  if (macro_bot_pressed){
+    if (BUTTON_DOWN(inputs, DOWNBUTTON)){}//button is still pressed, do nothing
+    else{
+      key_character = MACRODOWN;
+      keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, MACRO_SETTLE_MS);
+      macro_bot_pressed = 0;
+  }}
+  if (macro_lower_pressed){
+    if (BUTTON_DOWN(inputs, LOWERBUTTON)){
+      if(!isnan(packet->coordinate.a)){
+        //switch screen to jogmode
+        screenmode = JOGGING;
+        //send jog character
+        direction_pressed = JOG_AL;
+        //update_neopixels();
+      // } else {
+      //   key_character = MACROLOWER;
+      //   keypad_sendchar (key_character, 1, 1);
+      //   update_neopixels();
+      }
+    }//button is still pressed, Jog A Axis//button is still pressed, Jog A axis
+    else{
+        if(!isnan(packet->coordinate.a)){          
+          //gpio_put(KPSTR_PIN, false);
+          jog_toggle_pressed = 0;
+          joggle_reset = true;
+          update_neopixels();
+        }
+        else{
+          key_character = MACROLOWER;
+          keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, MACRO_SETTLE_MS);
+        }
+        macro_lower_pressed = 0;
+  }}  
+  if (macro_raise_pressed){
+    if (BUTTON_DOWN(inputs, RAISEBUTTON)){
+      if(!isnan(packet->coordinate.a)){
+        //switch screen to jogmode
+        screenmode = JOGGING;
+        //send jog character
+        direction_pressed = JOG_AR;
+        //update_neopixels();
+      // } else {
+      //   key_character = MACRORAISE;
+      //   keypad_sendchar (key_character, 1, 1);
+      //   update_neopixels();
+      }
+    }//button is still pressed, Jog A Axis//button is still pressed, Jog A axis
+    else{
+        if(!isnan(packet->coordinate.a)){        
+          //gpio_put(KPSTR_PIN, false);
+          jog_toggle_pressed = 0;
+          joggle_reset = true;
+          update_neopixels();
+        }
+        else{
+          key_character = MACRORAISE;
+          keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, MACRO_SETTLE_MS);
+        }
+        macro_raise_pressed = 0;
+  }}        
+  if (macro_spindle_pressed){
+    if (BUTTON_DOWN(inputs, SPINDLEBUTTON)){}//button is still pressed, do nothing
+    else{
+      key_character = MACROSPINDLE;
+      keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, MACRO_SETTLE_MS);
+      macro_spindle_pressed = 0;
+  }}
+  if (macro_home_pressed){
+    if (BUTTON_DOWN(inputs, HOMEBUTTON)){}//button is still pressed, do nothing
+    else{
+      key_character = MACROHOME;
+      keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, MACRO_SETTLE_MS);
+      macro_home_pressed = 0;
+  }}
+  if (reset_pressed){
+    if (BUTTON_DOWN(inputs, HOLDBUTTON)){}//button is still pressed, do nothing
+    else{
+      key_character = RESET;
+      keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_RESET_SCREEN | LINK_REFRESH_LEDS, MACRO_SETTLE_MS);
+      reset_pressed = 0;
+  }}
+  if (unlock_pressed){
+    if (BUTTON_DOWN(inputs, RUNBUTTON)){}//button is still pressed, do nothing
+    else{
+      key_character = UNLOCK;
+      keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, MACRO_SETTLE_MS);
+      unlock_pressed = 0;
+  }}
+  if (feed_down_fine_pressed) {
+    if (BUTTON_DOWN(inputs, FEEDOVER_DOWN)){}//button is still pressed, do nothing
+    else{
+      key_character = CMD_OVERRIDE_FEED_FINE_MINUS;
+      keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, MACRO_SETTLE_MS);
+      feed_down_fine_pressed = 0;
+   }}
+  if (feed_up_fine_pressed) {
+    if (BUTTON_DOWN(inputs, FEEDOVER_UP)){}//button is still pressed, do nothing
+    else{
+      key_character = CMD_OVERRIDE_FEED_FINE_PLUS;
+      keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, MACRO_SETTLE_MS);
+      feed_up_fine_pressed = 0;
+  }}
+  if (spin_down_fine_pressed) {
+    if (BUTTON_DOWN(inputs, SPINOVER_DOWN)){}//button is still pressed, do nothing
+    else{
+      key_character = CMD_OVERRIDE_SPINDLE_FINE_MINUS;
+      keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, MACRO_SETTLE_MS);
+      spin_down_fine_pressed = 0;
+  }}
+  if (spin_up_fine_pressed) {
+    if (BUTTON_DOWN(inputs, SPINOVER_UP)){}//button is still pressed, do nothing
+    else{
+      key_character = CMD_OVERRIDE_SPINDLE_FINE_PLUS;
+      keypad_sendchar (key_character, LINK_CLEAR_STROBE | LINK_REFRESH_LEDS, MACRO_SETTLE_MS);
+      spin_up_fine_pressed = 0;
+  }}  
+  if (page_next_pressed) {
+    if (BUTTON_DOWN(inputs, FEEDOVER_RESET)){}//button is still pressed, do nothing
+    else{
+      mailbox_post(&render_mailbox, RENDER_EV_PAGE_NEXT);
+      page_next_pressed = 0;
+  }}
+  if (page_prev_pressed) {
+    if (BUTTON_DOWN(inputs, SPINOVER_RESET)){}//button is still pressed, do nothing
+    else{
+      mailbox_post(&render_mailbox, RENDER_EV_PAGE_PREV);
+      page_prev_pressed = 0;
+  }}
+  if (halt_pressed){
+    if (BUTTON_DOWN(inputs, HALTBUTTON)){
+      pixels.setPixelColor(HALTLED,pixels.Color(0,255,0));
+      pixels.show();
+    }//button is still pressed, do nothing
+    else{
+      //store the flipped orientation and reboot, see screenflip_task()
+      screenflip_requested = true;
+      halt_pressed = 0;
+  }}
+
+  if (buttons_idle)
+    quiet_scans = quiet_scans < 2 ? quiet_scans + 1 : 2;
+  else
+    quiet_scans = 0;
+}
+
+// Jog engine: turns the held direction buttons into jog characters
+static void jog_task(void) {
+  //the scheduler runs this once per tick, the jog delays count ticks
+  if(direction_pressed){
+    rollover_delay++;
+    if(rollover_delay > ROLLOVER_DELAY_PERIOD)
+      rollover_delay = ROLLOVER_DELAY_PERIOD;
+
+    transition_delay = transition_delay - 1;
+    if(transition_delay < 0)
+      transition_delay = 0;
+  }
+
+//Handle jogging commands ***********************************************************************
+  if(direction_pressed){
+    
+    //draw_main_screen(0);
+    if(rollover_delay >= ROLLOVER_DELAY_PERIOD && previous_direction_pressed != direction_pressed){ //wait the elapsed time to handle multi-button press
+
+      uint8_t jog_flags = 0;
+      if (transition_delay <= 0){
+      previous_direction_pressed = direction_pressed;
+      jog_flags = LINK_STROBE_GAP; //new direction, drop the strobe briefly first
+      }
+      key_character = 0;
+      switch (direction_pressed) {
+        case JOG_XR :
+        key_character = CHAR_XR;
+        break;
+        case JOG_XL :
+        key_character = CHAR_XL;
+        break;
+        case JOG_YF :
+        key_character = CHAR_YB; //note inversion is intentional
+        break;
+        case JOG_YB :
+        key_character = CHAR_YF; //note inversion is intentional
+        break;
+        case JOG_ZU :
+        key_character = CHAR_ZU;
+        break;
+        case JOG_ZD :
+        key_character = CHAR_ZD;
+        break;
+        case JOG_XRYF :
+        key_character = CHAR_XRYF;
+        break;
+        case JOG_XRYB :
+        key_character = CHAR_XRYB;
+        break;
+        case JOG_XLYF :
+        key_character = CHAR_XLYF;
+        break;
+        case JOG_XLYB :
+        key_character = CHAR_XLYB;
+        break;
+        /*case JOG_XRZU :
+        key_character = 'w';
+        break;
+        case JOG_XRZD :
+        key_character = 'v';
+        break;
+        case JOG_XLZU :
+        key_character = 'u';
+        break;
+        case JOG_XLZD :
+        key_character = 'x';
+        break;*/
+        case JOG_AL :
+        key_character = CHAR_AL;
+        break;   
+        case JOG_AR :
+        key_character = CHAR_AR;
+        break;                                                                                                                                                                                     
+        default:
+        break;
+      }
+      if (jog_flags){
+        link_release_strobe(); //cancel whatever the old direction still has queued
+        if (key_character)
+          keypad_sendchar (key_character, jog_flags, 0);
+      } else if (key_character && link_idle()){
+        keypad_sendchar (key_character, 0, 0);
+      }
+    }
+    //check for button transitions
+    if (previous_direction_pressed == direction_pressed){
+      transition_delay = packet->feed_rate / 10;
+      if(transition_delay < 30)
+        transition_delay = 30;
+
+      if(transition_delay > 250)
+        transition_delay= 250;
+    }
+  } else{
+    direction_pressed = 0;
+    previous_direction_pressed = direction_pressed;
+    rollover_delay = 0;
+    transition_delay = 0;
+  }
+}
 
-  gpio_init(FEEDOVER_RESET);
-  gpio_set_dir(FEEDOVER_RESET, GPIO_IN);
-  gpio_set_pulls(FEEDOVER_RESET,true,false);
+static void leds_task(void) {
+  if (packet->status_code != Status_UserException && !context.mem_address_written)
+    update_neopixels();
+}
 
-  gpio_init(SPINDLEBUTTON);
-  gpio_set_dir(SPINDLEBUTTON, GPIO_IN);
-  gpio_set_pulls(SPINDLEBUTTON,true,false);
+// Screen flip, idle status refresh, the start-up loop check and the scheduler statistics
+static void house_task(void) {
+  static absolute_time_t status_deadline = make_timeout_time_ms(STATUS_REFRESH_MS);
+  static absolute_time_t loop_check_deadline = make_timeout_time_ms(LOOP_CHECK_MS);
+#ifdef SHOWSCHED
+  static absolute_time_t report_deadline = make_timeout_time_ms(SCHED_REPORT_MS);
+  static uint32_t report_frames = 0; // oled_frames at the last report
+#endif
+
+  screenflip_task(&screenflip_state);
+
+  if (buttons_idle && time_reached(status_deadline)){
+    status_deadline = make_timeout_time_ms(STATUS_REFRESH_MS);
+    mailbox_post(&render_mailbox, RENDER_EV_REFRESH);
+    update_neopixels();
+  }
+  // The check of the no-blocking rule: every pass of the first LOOP_CHECK_MS
+  // has to stay within LOOP_STALL_BUDGET_US, a failure is also put on screen
+  if (!loop_check_done && time_reached(loop_check_deadline)){
+    loop_check_done = true;
+    printf("loop check: %s, worst pass %lu us, budget %lu us, %lu stalls\n", loop_check_stalls ? "FAIL" : "PASS",
+           (unsigned long)loop_check_max_us, (unsigned long)LOOP_STALL_BUDGET_US, (unsigned long)loop_check_stalls);
+    if (loop_check_stalls)
+      mailbox_post(&render_mailbox, RENDER_EV_LOOP_STALL);
+  }
+#ifdef SHOWSCHED
+  if (time_reached(report_deadline)){
+    report_deadline = make_timeout_time_ms(SCHED_REPORT_MS);
+    sched_report(true);
+    printf("oled: %lu frames, last %lu bytes, avg %lu bytes/frame, %lu.%lu fps\n", (unsigned long)oled_frames,
+           (unsigned long)oled_frame_bytes, (unsigned long)(oled_frames ? oled_total_bytes / oled_frames : 0),
+           (unsigned long)((oled_frames - report_frames) * 10000 / SCHED_REPORT_MS / 10),
+           (unsigned long)((oled_frames - report_frames) * 10000 / SCHED_REPORT_MS % 10));
+    report_frames = oled_frames;
+    printf("ui: %lu redraws avoided, the text on screen did not change\n", (unsigned long)ui_redraws_avoided);
+    printf("loop: worst pass %lu us, mean %lu us over %lu passes, %lu stalls, render on core%d\n", (unsigned long)loop_max_us,
+           (unsigned long)(loop_passes ? loop_total_us / loop_passes : 0), (unsigned long)loop_passes,
+           (unsigned long)loop_stalls, RENDER_CORE1 ? 1 : 0);
+    loop_max_us = 0;
+    loop_stalls = 0;
+    loop_passes = 0;
+    loop_total_us = 0;
+  }
+#endif
+}
 
-  gpio_init(RUNBUTTON);
-  gpio_set_dir(RUNBUTTON, GPIO_IN);
-  gpio_set_pulls(RUNBUTTON,true,false);
+// Sorted by priority in sched_init(), lower runs first when both are due
+static sched_task_t task_table[] = {
+  // name      function     period_us                   budget_us           priority
+  { "link",    link_poll,   LINK_PERIOD_US,             LINK_BUDGET_US,     0 },
+  { "input",   input_task,  INPUT_PERIOD_US,            INPUT_BUDGET_US,    1 },
+  { "jog",     jog_task,    TICK_TIMER_PERIOD * 1000,   JOG_BUDGET_US,      2 },
+  { "publish", publish_task, RENDER_PERIOD_US,          PUBLISH_BUDGET_US,  3 },
+#if !RENDER_CORE1
+  { "render",  render_task, RENDER_PERIOD_US,           RENDER_BUDGET_US,   4 },
+#endif
+  { "leds",    leds_task,   LED_UPDATE_PERIOD * TICK_TIMER_PERIOD * 1000, LEDS_BUDGET_US, 5 },
+  { "house",   house_task,  HOUSE_PERIOD_US,            HOUSE_BUDGET_US,    6 },
+};
 
-  gpio_init(HOLDBUTTON);
-  gpio_set_dir(HOLDBUTTON, GPIO_IN);
-  gpio_set_pulls(HOLDBUTTON,true,false);
+// Main loop - initilises system and then loops while interrupts get on with processing the data
+
+/*
+red = (255, 0, 0)
+orange = (255, 165, 0)
+yellow = (255, 150, 0)
+green = (0, 255, 0)
+blue = (0, 0, 255)
+indigo = (75, 0, 130)
+violet = (138, 43, 226)
+off = (0, 0, 0)
+*/
 
-  gpio_init(MISTBUTTON);
-  gpio_set_dir(MISTBUTTON, GPIO_IN);
-  gpio_set_pulls(MISTBUTTON,true,false);
+#ifdef BENCH_OLED_BUS
+// Pushes the whole 1KB back buffer over each OLED bus backend and prints how
+// long the frame took and the bus rate actually achieved (9 clocks per byte)
+static void bench_oled_bus(void) {
+  static const struct { uint8_t bus; uint32_t hz; const char *name; } runs[] = {
+    {I2C_BACKEND_BITBANG, 400000, "bitbang 400K"},
+    {I2C_BACKEND_BITBANG, 1000000, "bitbang 1M"},
+    {board.oled_bus, OLED_BUS_HZ, "board"},
+  };
+  BBI2C *bus = display_bus();
+  uint32_t start, us, bytes;
+
+  for (unsigned i = 0; i < sizeof(runs) / sizeof(runs[0]); i++) {
+    bus->bWire = runs[i].bus;
+    I2CInit(bus, runs[i].hz);
+    start = time_us_32();
+    bytes = display_dump();
+    I2CWait(bus);
+    us = time_us_32() - start;
+    printf("oled bus %-12s: frame %lu us, %lu bytes, %lu kHz\n", runs[i].name, (unsigned long)us,
+           (unsigned long)bytes, (unsigned long)(us ? bytes * 9 * 1000 / us : 0));
+  }
+  bus->bWire = board.oled_bus;
+  I2CInit(bus, OLED_BUS_HZ);
+}
+#endif
+
+#ifdef BENCH_DISPLAY
+// Times the display backend on the boot layout: drawing every widget into the
+// back buffer, sending a whole frame and sending one changed field. Build it
+// once per backend (-DJOG2K_DISPLAY=ss_oled / obd) to compare them.
+#define BENCH_DISPLAY_RUNS 20
+static uint32_t bench_display_flush(uint32_t *bytes) {
+  uint32_t start = time_us_32();
+
+  *bytes = display_flush();
+  while (!display_frame_done())
+    tight_loop_contents();
+  return time_us_32() - start;
+}
 
-  gpio_init(FLOODBUTTON);
-  gpio_set_dir(FLOODBUTTON, GPIO_IN);
-  gpio_set_pulls(FLOODBUTTON,true,false);
+static void bench_display(void) {
+  uint32_t start, draw_us, frame_us, frame_bytes, field_us, field_bytes;
 
-  gpio_init(HOMEBUTTON);
-  gpio_set_dir(HOMEBUTTON, GPIO_IN);
-  gpio_set_pulls(HOMEBUTTON,true,false);
+  start = time_us_32();
+  for (int i = 0; i < BENCH_DISPLAY_RUNS; i++) {
+    draw_main_screen(1);
+    while (!widget_update_slice(RENDER_BUDGET_US))
+      ;
+  }
+  draw_us = (time_us_32() - start) / BENCH_DISPLAY_RUNS;
+  render_phase = RENDER_IDLE;
+  display_invalidate();
+  frame_us = bench_display_flush(&frame_bytes);
+  display_text(0, 3, "-1234.567", FONT_8x8, 0);
+  field_us = bench_display_flush(&field_bytes);
+  printf("display %s: draw %lu us, frame %lu us %lu bytes, one field %lu us %lu bytes\n", display_name(),
+         (unsigned long)draw_us, (unsigned long)frame_us, (unsigned long)frame_bytes, (unsigned long)field_us,
+         (unsigned long)field_bytes);
+}
+#endif
+
+#ifdef BENCH_DRO
+// Format a sweep of coordinates with printf and with dro_format(), compare
+// the text and print the time per number for both
+#define BENCH_DRO_COUNT 2000
+static void bench_dro(void) {
+  char ref[24], dro[24];
+  uint32_t start, printf_us = 0, dro_us = 0, mismatch = 0;
+  float value;
+
+  for (int decimals = 3; decimals <= 4; decimals++) {
+    for (int i = 0; i < BENCH_DRO_COUNT; i++) {
+      value = (i - BENCH_DRO_COUNT / 2) * 0.3779f + i / 16.0f;
+      start = time_us_32();
+      snprintf(ref, sizeof(ref), decimals == 4 ? "%8.4F" : "%8.3F", value);
+      printf_us += time_us_32() - start;
+      start = time_us_32();
+      dro_format(dro, value, 8, decimals);
+      dro_us += time_us_32() - start;
+      if (strcmp(ref, dro))
+        mismatch++;
+    }
+  }
+  printf("dro format: printf %lu ns, fixed point %lu ns per number, %lu mismatches\n",
+         (unsigned long)(printf_us * 500 / BENCH_DRO_COUNT), (unsigned long)(dro_us * 500 / BENCH_DRO_COUNT),
+         (unsigned long)mismatch);
+}
+#endif
+
+// Display, boot screen and the benchmarks, on the core that renders: the
+// display bus and its DMA interrupt belong to the core that set them up
+static void render_init(void) {
+  render_receive();
+  rc = display_init(board.oled_type, screenflip, board.oled_bus, SDA_PIN, SCL_PIN, RESET_PIN, OLED_BUS_HZ);
+  widget_init();
+  display_fill(0);
+  asset_draw(&splash_wheel, 0, 0, false);
+  display_text(40, 1, "JOG2K", FONT_16x16, 0); //FONT_12x16 is for numbers
+  display_text(0, 5, JOG2K_VERSION, FONT_8x8, 0);
+  display_text(0, 7, PLUGIN_VERSION, FONT_6x8, 0);
+  display_flush();
+#ifdef BENCH_DISPLAY
+  bench_display();
+#endif
+#ifdef BENCH_OLED_BUS
+  bench_oled_bus();
+#endif
+#ifdef BENCH_DRO
+  bench_dro();
+#endif
+  sleep_ms(1000);
+  display_fill(0);
+  ui_invalidate(1);
+}
 
-  gpio_init(SPINOVER_UP);
-  gpio_set_dir(SPINOVER_UP, GPIO_IN);
-  gpio_set_pulls(SPINOVER_UP,true,false);
+#if RENDER_CORE1
+// Core1 runs the render side and nothing else. It sleeps until core0
+// publishes (the mailbox ends with __sev()), the DMA interrupt of a frame
+// fires or RENDER_PERIOD_US is up for the governor, notifications and the
+// ticker, and only keeps going while a frame is being drawn.
+static void render_core1(void) {
+  multicore_lockout_victim_init(); //core0 stops it to write the screen flip to flash
+  render_init();
+  while (true) {
+    render_task();
+    if (render_phase == RENDER_IDLE || (render_phase == RENDER_FLUSH && !display_frame_done()))
+      best_effort_wfe_or_timeout(make_timeout_time_us(RENDER_PERIOD_US));
+  }
+}
+#endif
 
-  gpio_init(SPINOVER_DOWN);
-  gpio_set_dir(SPINOVER_DOWN, GPIO_IN);
-  gpio_set_pulls(SPINOVER_DOWN,true,false);
+int main() {
 
-  gpio_init(SPINOVER_RESET);
-  gpio_set_dir(SPINOVER_RESET, GPIO_IN);
-  gpio_set_pulls(SPINOVER_RESET,true,false);
+  stdio_init_all();
+
+  // one-shot init of every button and output GPIO described by the board profile
+  gpio_init_mask(BOARD_INPUT_MASK | BOARD_OUTPUT_MASK);
+  gpio_set_dir_masked(BOARD_INPUT_MASK | BOARD_OUTPUT_MASK, BOARD_OUTPUT_MASK);
+  for (int b = 0; b < BUTTON_COUNT; b++)
+    gpio_set_pulls(board.button[b], true, false);
 
-  gpio_init(ONBOARD_LED);
-  gpio_set_dir(ONBOARD_LED, GPIO_OUT);
   gpio_put(ONBOARD_LED, 1);
   sleep_ms(250);
   gpio_put(ONBOARD_LED, 0);
   sleep_ms(250);
   gpio_put(ONBOARD_LED, 1);
 
-  struct repeating_timer timer;
-  add_repeating_timer_ms(TICK_TIMER_PERIOD, tick_timer_callback, NULL, &timer);
-  
   pixels.begin(); // INITIALIZE NeoPixel strip object (REQUIRED)
   pixels.setBrightnessFunctions(adjust,adjust,adjust,adjust);
   
@@ -927,11 +2200,10 @@ int main() {
 
 // Setup I2C0 as slave (peripheral)
 setup_slave();
+setup_button_irqs();
 packet->system_state = SystemState_Undefined; // ADD STATUS FOR CONTROLLER DISCONNECTED?
 packet->status_code = Status_UserException; // ADD STATUS FOR CONTROLLER DISCONNECTED?
 key_character = CMD_STATUS_REPORT_LEGACY;
-//keypad_sendchar (key_character, 1, 1);
-status_update_counter = STATUS_REQUEST_PERIOD;
 
 if (*flash_target_contents != 0xff)
   screenflip = *flash_target_contents;
@@ -939,649 +2211,54 @@ if (*flash_target_contents != 0xff)
 uint8_t uc[8];
 int i, j;
 char szTemp[32];
-    
-rc = oledInit(&oled, OLED_128x64, 0x3c, screenflip, 0, 0, SDA_PIN, SCL_PIN, RESET_PIN, 1000000L);
-oledSetBackBuffer(&oled, ucBuffer);
-oledFill(&oled, 0,1);
-oledWriteString(&oled, 0,0,1,(char *)"JOG2K", FONT_12x16, 0, 1);
-oledWriteString(&oled, 0,0,4,(char *)JOG2K_VERSION, FONT_8x8, 0, 1);
-oledWriteString(&oled, 0,0,7,(char *)PLUGIN_VERSION, FONT_6x8, 0, 1);
-sleep_ms(1000);
-oledFill(&oled, 0,1);
-
-draw_main_screen(1);
-
-    // Main loop handles the buttons, everything else handled in interrupts
-    while (true) {
 
-        //draw_main_screen(1);
-        
-        // if (!packet->machine_state.disconnected){
-        //   current_jogmode = (Jogmode) (packet->jog_mode.mode);
-        //   current_jogmodify =  (Jogmodify) (packet->jog_mode.modifier);
-        // }
-
-        if( packet->system_state != previous_packet->system_state ||
-            packet->feed_override != previous_packet->feed_override ||
-            packet->spindle_override != previous_packet->spindle_override||
-            packet->jog_mode.value != previous_packet->jog_mode.value ||
-            packet->coordinate.x != previous_packet->coordinate.x ||
-            packet->coordinate.y != previous_packet->coordinate.y ||
-            packet->coordinate.z != previous_packet->coordinate.z ||
-            (!isnan(packet->coordinate.a) && (packet->coordinate.a != previous_packet->coordinate.a)) ||                  
-            packet->current_wcs != previous_packet->current_wcs ||
-            packet->jog_stepsize != previous_packet->jog_stepsize ||
-            packet->feed_rate != previous_packet->feed_rate ||
-            packet->spindle_rpm != previous_packet->spindle_rpm ||
-            packet->jog_mode.modifier != previous_packet->jog_mode.modifier ||
-            screenmode != previous_screenmode
-            ){          
-          draw_main_screen(1);        
-        }
+packet_event = true;
+publish_task(); //the render side starts from the disconnected packet
+#if RENDER_CORE1
+multicore_launch_core1(render_core1);
+#else
+render_init();
+#endif
 
-        //if(screenmode != previous_screenmode)
-        //  draw_main_screen(1);
-        
-        if(packet->system_state == SystemState_Jog){
-          draw_main_screen(1);
-          update_neopixels();
-        }
-
-        if (update_neopixel_leds && (packet->status_code != Status_UserException) ){
-          if(!context.mem_address_written) // >= offsetof(machine_status_packet_t, msgtype))          
-            update_neopixels();
-          update_neopixel_leds = 0;
-        }
-
-        //BUTTON READING ***********************************************************************
-        if(gpio_get(HALTBUTTON)){
-          pixels.setPixelColor(HALTLED,pixels.Color(0, 0, 0));        
-          key_character = 0x18;
-          //while(gpio_get(HALTBUTTON))
-          //  sleep_ms(250);     
-        } else if (gpio_get(HOLDBUTTON)){
-          pixels.setPixelColor(HOLDLED,pixels.Color(0, 0, 0));
-          if(!jog_toggle_pressed){             
-          key_character = CMD_FEED_HOLD ;
-          keypad_sendchar(key_character, 1, 1);
-          while(gpio_get(HOLDBUTTON))
-            sleep_us(100);
-          } 
-          //gpio_put(KPSTR_PIN, false);
-                                
-        } else if (gpio_get(RUNBUTTON)){
-          pixels.setPixelColor(RUNLED,pixels.Color(0, 0, 0));
-          if(!jog_toggle_pressed){             
-          key_character = CMD_CYCLE_START ;
-          keypad_sendchar(key_character, 1, 1);
-          while(gpio_get(RUNBUTTON))
-            sleep_us(100);
-          }
-          //gpio_put(KPSTR_PIN, false);    
-        //misc commands.  These activate on lift
-        } else if (gpio_get(SPINOVER_UP)){  
-          if(!jog_toggle_pressed){    
-            spin_up_pressed = 1;
-          }            
-        } else if (gpio_get(SPINOVER_DOWN)){
-          if(!jog_toggle_pressed){    
-            spin_down_pressed = 1;
-          }
-        } else if (gpio_get(SPINOVER_RESET)){  
-          spin_reset_pressed = 1; 
-        } else if (gpio_get(FEEDOVER_UP)){
-          if(!jog_toggle_pressed){    
-            feed_up_pressed = 1;
-          }    
-        } else if (gpio_get(FEEDOVER_DOWN)){
-          if(!jog_toggle_pressed){     
-            feed_down_pressed = 1;
-          }            
-        } else if (gpio_get(FEEDOVER_RESET)){  
-          feed_reset_pressed = 1;              
-        } else if (gpio_get(HOMEBUTTON)){  
-          home_pressed = 1;        
-        } else if (gpio_get(MISTBUTTON)){  
-          mist_pressed = 1;
-        } else if (gpio_get(FLOODBUTTON)){  
-          flood_pressed = 1;   
-        } else if (gpio_get(SPINDLEBUTTON)){ 
-          spinoff_pressed = 1;
-        } else if (gpio_get(JOG_SELECT) && (!joggle_reset)){  //Toggle Jog modes
-          jog_toggle_pressed = 1;
-        } else if (!jog_toggle_pressed &&//only read jog actions when jog toggle is released.
-                   gpio_get(UPBUTTON) ||
-                   gpio_get(RIGHTBUTTON) ||
-                   gpio_get(DOWNBUTTON) ||
-                   gpio_get(LEFTBUTTON) ||
-                   gpio_get(RAISEBUTTON) ||
-                   gpio_get(LOWERBUTTON) ){
-          activate_jogled();
-          direction_pressed = 0;           
-          direction_pressed = direction_pressed | gpio_get(UPBUTTON) << UP;
-          direction_pressed = direction_pressed | gpio_get(RIGHTBUTTON) << RIGHT;
-          direction_pressed = direction_pressed | gpio_get(DOWNBUTTON) << DOWN;
-          direction_pressed = direction_pressed | gpio_get(LEFTBUTTON) << LEFT;
-          direction_pressed = direction_pressed | gpio_get(RAISEBUTTON) << RAISE;
-          direction_pressed = direction_pressed | gpio_get(LOWERBUTTON) << LOWER;
-        } else {
-            if(direction_pressed){
-              direction_pressed = 0;
-              rollover_delay = 0;
-            }
-            joggle_reset = false;       
-            gpio_put(KPSTR_PIN, false); //make sure stobe is clear when no button is pressed.
-          if (status_update_counter < 1){
-            status_update_counter = STATUS_REQUEST_PERIOD;
-            draw_main_screen(1);
-            update_neopixels();
-          }
-        }        
+    sched_init(task_table, sizeof(task_table) / sizeof(task_table[0]));
 
-          //close button reads
-//Handle jogging commands ***********************************************************************
-        if(direction_pressed){
-          
-          //draw_main_screen(0);
-          if(rollover_delay >= ROLLOVER_DELAY_PERIOD && previous_direction_pressed != direction_pressed){ //wait the elapsed time to handle multi-button press
-
-            if (transition_delay <= 0){
-            previous_direction_pressed = direction_pressed;
-            gpio_put(KPSTR_PIN, false);
-            sleep_ms(5);
-            }
-            switch (direction_pressed) {
-              case JOG_XR :
-              key_character = CHAR_XR;
-              keypad_sendchar (key_character, 0, 1);
-              break;
-              case JOG_XL :
-              key_character = CHAR_XL;
-              keypad_sendchar (key_character, 0, 1);
-              break;
-              case JOG_YF :
-              key_character = CHAR_YB; //note inversion is intentional
-              keypad_sendchar (key_character, 0, 1);
-              break;
-              case JOG_YB :
-              key_character = CHAR_YF; //note inversion is intentional
-              keypad_sendchar (key_character, 0, 1);
-              break;
-              case JOG_ZU :
-              key_character = CHAR_ZU;
-              keypad_sendchar (key_character, 0, 1);
-              break;
-              case JOG_ZD :
-              key_character = CHAR_ZD;
-              keypad_sendchar (key_character, 0, 1);
-              break;
-              case JOG_XRYF :
-              key_character = CHAR_XRYF;
-              keypad_sendchar (key_character, 0, 1);
-              break;
-              case JOG_XRYB :
-              key_character = CHAR_XRYB;
-              keypad_sendchar (key_character, 0, 1);
-              break;
-              case JOG_XLYF :
-              key_character = CHAR_XLYF;
-              keypad_sendchar (key_character, 0, 1);
-              break;
-              case JOG_XLYB :
-              key_character = CHAR_XLYB;
-              keypad_sendchar (key_character, 0, 1);
-              break;
-              /*case JOG_XRZU :
-              key_character = 'w';
-              keypad_sendchar (key_character, 0, 1);
-              break;
-              case JOG_XRZD :
-              key_character = 'v';
-              keypad_sendchar (key_character, 0, 1);
-              break;
-              case JOG_XLZU :
-              key_character = 'u';
-              keypad_sendchar (key_character, 0, 1);
-              break;
-              case JOG_XLZD :
-              key_character = 'x';
-              keypad_sendchar (key_character, 0, 1);
-              break;*/
-              case JOG_AL :
-              key_character = CHAR_AL;
-              keypad_sendchar (key_character, 0, 1);
-              break;   
-              case JOG_AR :
-              key_character = CHAR_AR;
-              keypad_sendchar (key_character, 0, 1);
-              break;                                                                                                                                                                                     
-              default:
-              break;
-            }
-          }
-          //check for button transitions
-          if (previous_direction_pressed == direction_pressed){
-            transition_delay = packet->feed_rate / 10;
-            if(transition_delay < 30)
-              transition_delay = 30;
-
-            if(transition_delay > 250)
-              transition_delay= 250;
+    // Main loop runs whichever scheduler task is due and sleeps when nothing is,
+    // the I2C link and the button edges are handled in interrupts
+    while (true) {
+        uint32_t loop_start_us = time_us_32();
+
+        if (!sched_dispatch()){
+          if (input_event)
+            sched_trigger(input_task);
+          if (link_event){
+            link_event = false;
+            sched_trigger(link_poll);
           }
-        } else{
-          direction_pressed = 0;
-          previous_direction_pressed = direction_pressed;
-          rollover_delay = 0;
-          transition_delay = 0;
+          if (packet_event)
+            sched_trigger(publish_task);
+#if !RENDER_CORE1
+          if ((render_phase == RENDER_DRAW) || (render_phase == RENDER_FLUSH && display_frame_done()))
+            sched_trigger(render_task); // the DMA interrupt that ends a frame wakes the core too
+#endif
+          sched_idle();
+          continue;
         }
 
-//SINGLE BUTTON PRESSES ***********************************************************************
-//Alternate functions ***********************************************************************
-        if (jog_toggle_pressed){  //Pure modifier button.          
-          if (gpio_get(JOG_SELECT)){//keyis still helddown, check alternate keys.
-            screenmode = JOG_MODIFY;
-            update_neopixels();
-            //draw_main_screen(1);
-            if (gpio_get(FLOODBUTTON)){
-              jog_mod_pressed = 1;
-            }
-            if (gpio_get(MISTBUTTON)){
-              jog_mode_pressed = 1;
-            }
-            if (gpio_get(LEFTBUTTON)){
-              macro_left_pressed = 1;
-            } 
-            if (gpio_get(RIGHTBUTTON)){
-              macro_right_pressed = 1;
-            } 
-            if (gpio_get(UPBUTTON)){
-              macro_top_pressed = 1;
-            } 
-            if (gpio_get(DOWNBUTTON)){
-              macro_bot_pressed = 1;
-            } 
-            if (gpio_get(RAISEBUTTON)){
-              macro_raise_pressed = 1;
-            } 
-            if (gpio_get(LOWERBUTTON)){
-              macro_lower_pressed = 1;
-            }
-            if (gpio_get(HOMEBUTTON)){
-              macro_home_pressed = 1;
-            }  
-            if (gpio_get(SPINDLEBUTTON)){
-              macro_spindle_pressed = 1;
-            }  
-            if (gpio_get(HOLDBUTTON)){
-              reset_pressed = 1;
-            }  
-            if (gpio_get(RUNBUTTON)){
-              unlock_pressed = 1;
-            }
-            if (gpio_get(HALTBUTTON)){
-              halt_pressed = 1;              
-            }
-            if (gpio_get(SPINOVER_UP)){  
-              spin_up_fine_pressed = 1;            
-            }
-            if (gpio_get(SPINOVER_DOWN)){  
-              spin_down_fine_pressed = 1;
-            }
-            if (gpio_get(FEEDOVER_UP)){ 
-              feed_up_fine_pressed = 1;    
-            }
-            if (gpio_get(FEEDOVER_DOWN)){ 
-              feed_down_fine_pressed = 1;            
-            }                                                                                                                    
-          }//close jog toggle pressed.
-        }//close jog button pressed statement
-//Single functions ***********************************************************************
-        if (jog_toggle_pressed) {
-          if (gpio_get(JOG_SELECT)){}//button is still pressed, do nothing
-          else{
-            jog_toggle_pressed = 0;
-            screenmode = DEFAULT;
-            update_neopixels();                         
-          }
-        }
-        if (feed_down_pressed) {
-          if (gpio_get(FEEDOVER_DOWN)){}//button is still pressed, do nothing
-          else{
-            key_character = CMD_OVERRIDE_FEED_COARSE_MINUS;
-            keypad_sendchar (key_character, 1, 1);
-            gpio_put(ONBOARD_LED,1);
-            feed_down_pressed = 0;
-            update_neopixels();                       
-          }
-        }
-        if (feed_up_pressed) {
-          if (gpio_get(FEEDOVER_UP)){}//button is still pressed, do nothing
-          else{
-            key_character = CMD_OVERRIDE_FEED_COARSE_PLUS;
-            keypad_sendchar (key_character, 1, 1);
-            gpio_put(ONBOARD_LED,1);
-            feed_up_pressed = 0;
-            update_neopixels();                
-          }
-        }
-        if (feed_reset_pressed) {
-          if (gpio_get(FEEDOVER_RESET)){}//button is still pressed, do nothing
-          else{
-            key_character = CMD_OVERRIDE_FEED_RESET;
-            keypad_sendchar (key_character, 1, 1);
-            gpio_put(ONBOARD_LED,1);
-            feed_reset_pressed = 0;
-            update_neopixels();                
-          }
-        }
-        if (spin_down_pressed) {
-          if (gpio_get(SPINOVER_DOWN)){}//button is still pressed, do nothing
-          else{
-            key_character = CMD_OVERRIDE_SPINDLE_COARSE_MINUS;
-            keypad_sendchar (key_character, 1, 1);
-            gpio_put(ONBOARD_LED,1);
-            spin_down_pressed = 0;
-            update_neopixels();           
-          }
-        }
-        if (spin_up_pressed) {
-          if (gpio_get(SPINOVER_UP)){}//button is still pressed, do nothing
-          else{
-            key_character = CMD_OVERRIDE_SPINDLE_COARSE_PLUS;
-            keypad_sendchar (key_character, 1, 1);
-            gpio_put(ONBOARD_LED,1);
-            spin_up_pressed = 0;
-            update_neopixels();         
-          }
-        }
-        if (spin_reset_pressed) {
-          if (gpio_get(SPINOVER_RESET)){}//button is still pressed, do nothing
-          else{
-            key_character = CMD_OVERRIDE_SPINDLE_RESET;
-            keypad_sendchar (key_character, 1, 1);
-            gpio_put(ONBOARD_LED,1);
-            spin_reset_pressed = 0;
-            update_neopixels();          
-          }
-        }
-        if (mist_pressed) {
-          if (gpio_get(MISTBUTTON)){}//button is still pressed, do nothing
-          else{
-            if(!jog_toggle_pressed){
-            key_character = CMD_OVERRIDE_COOLANT_MIST_TOGGLE;
-            keypad_sendchar (key_character, 1, 1);
-            gpio_put(ONBOARD_LED,1);
-            }
-            mist_pressed = 0;
-            update_neopixels();           
-          }
-        }
-        if (flood_pressed) {
-          if (gpio_get(FLOODBUTTON)){}//button is still pressed, do nothing
-          else{
-            if(!jog_toggle_pressed){
-            key_character = CMD_OVERRIDE_COOLANT_FLOOD_TOGGLE;
-            keypad_sendchar (key_character, 1, 1);
-            gpio_put(ONBOARD_LED,1);
-            }
-            flood_pressed = 0;
-            update_neopixels();           
-          }                    
-        }
-        if (spinoff_pressed) {
-          if (gpio_get(SPINDLEBUTTON)){}//button is still pressed, do nothing
-          else{
-            if(!jog_toggle_pressed){
-            key_character = CMD_OVERRIDE_SPINDLE_STOP;
-            keypad_sendchar (key_character, 1, 1);
-            gpio_put(ONBOARD_LED,1);
-            }
-            spinoff_pressed = 0;
-            update_neopixels();           
-          }                    
-        } 
-        if (home_pressed) {
-          if (gpio_get(HOMEBUTTON)){}//button is still pressed, do nothing
-          else{
-            if(!jog_toggle_pressed){
-            key_character = 'H';         
-            keypad_sendchar (key_character, 1, 1);
-            gpio_put(ONBOARD_LED,1);
-          }
-            home_pressed = 0;         
-            update_neopixels();          
-          }                    
-        }
-        if (jog_mod_pressed) {
-          if (gpio_get(FLOODBUTTON)){}//button is still pressed, do nothing
-          else{
-            key_character = JOGMODIFY_CYCLE;
-            keypad_sendchar (key_character, 1, 1);
-            gpio_put(ONBOARD_LED,1);
-            jog_mod_pressed = 0;
-            sleep_ms(10);
-            update_neopixels();                       
-          }
-        }
-        if (jog_mode_pressed) {
-          if (gpio_get(MISTBUTTON)){}//button is still pressed, do nothing
-          else{
-            key_character = JOGMODE_CYCLE;     
-            keypad_sendchar (key_character, 1, 1);
-            //gpio_put(KPSTR_PIN, false);
-            gpio_put(ONBOARD_LED,1);
-            jog_mode_pressed = 0;
-            sleep_ms(10);
-            update_neopixels();                   
-          }
+        // nothing in the loop may block, count any pass that took too long,
+        // house_task() reports them and checks the first LOOP_CHECK_MS
+        uint32_t loop_dt_us = time_us_32() - loop_start_us;
+        if (loop_dt_us > loop_max_us)
+          loop_max_us = loop_dt_us;
+        loop_passes++;
+        loop_total_us += loop_dt_us;
+        if (loop_dt_us > LOOP_STALL_BUDGET_US)
+          loop_stalls++;
+        if (!loop_check_done){
+          if (loop_dt_us > loop_check_max_us)
+            loop_check_max_us = loop_dt_us;
+          if (loop_dt_us > LOOP_STALL_BUDGET_US)
+            loop_check_stalls++;
         }
-        if (macro_left_pressed){
-          if (gpio_get(LEFTBUTTON)){}//button is still pressed, do nothing
-          else{
-            key_character = MACROLEFT;
-            keypad_sendchar (key_character, 1, 1);
-            gpio_put(ONBOARD_LED,1);
-            macro_left_pressed = 0;
-            sleep_ms(10);
-            update_neopixels();
-        }}
-        if (macro_right_pressed){
-          if (gpio_get(RIGHTBUTTON)){}//button is still pressed, do nothing
-          else{
-            key_character = MACRORIGHT;
-            keypad_sendchar (key_character, 1, 1);
-            gpio_put(ONBOARD_LED,1);
-            macro_right_pressed = 0;
-            sleep_ms(10);
-            update_neopixels();
-        }}
-        if (macro_top_pressed){
-          if (gpio_get(UPBUTTON)){}//button is still pressed, do nothing
-          else{
-            key_character = MACROUP;
-            keypad_sendchar (key_character, 1, 1);
-            gpio_put(ONBOARD_LED,1);
-            macro_top_pressed = 0;
-            sleep_ms(10);
-            update_neopixels();
-        }}
-        if (macro_bot_pressed){
-          if (gpio_get(DOWNBUTTON)){}//button is still pressed, do nothing
-          else{
-            key_character = MACRODOWN;
-            keypad_sendchar (key_character, 1, 1);
-            gpio_put(ONBOARD_LED,1);
-            macro_bot_pressed = 0;
-            sleep_ms(10);
-            update_neopixels();
-        }}
-        if (macro_lower_pressed){
-          if (gpio_get(LOWERBUTTON)){
-            if(!isnan(packet->coordinate.a)){
-              //switch screen to jogmode
-              screenmode = JOGGING;
-              //send jog character
-              direction_pressed = JOG_AL;
-              //update_neopixels();
-            // } else {
-            //   key_character = MACROLOWER;
-            //   keypad_sendchar (key_character, 1, 1);
-            //   update_neopixels();
-            }
-          }//button is still pressed, Jog A Axis//button is still pressed, Jog A axis
-          else{
-              if(!isnan(packet->coordinate.a)){          
-                //gpio_put(KPSTR_PIN, false);
-                jog_toggle_pressed = 0;
-                joggle_reset = true;
-              }
-              else{
-                key_character = MACROLOWER;
-                keypad_sendchar (key_character, 1, 1);
-              }
-              gpio_put(ONBOARD_LED,1);
-              macro_lower_pressed = 0;
-              sleep_ms(10);
-              update_neopixels();
-        }}  
-        if (macro_raise_pressed){
-          if (gpio_get(RAISEBUTTON)){
-            if(!isnan(packet->coordinate.a)){
-              //switch screen to jogmode
-              screenmode = JOGGING;
-              //send jog character
-              direction_pressed = JOG_AR;
-              //update_neopixels();
-            // } else {
-            //   key_character = MACRORAISE;
-            //   keypad_sendchar (key_character, 1, 1);
-            //   update_neopixels();
-            }
-          }//button is still pressed, Jog A Axis//button is still pressed, Jog A axis
-          else{
-              if(!isnan(packet->coordinate.a)){        
-                //gpio_put(KPSTR_PIN, false);
-                jog_toggle_pressed = 0;
-                joggle_reset = true;
-              }
-              else{
-                key_character = MACRORAISE;
-                keypad_sendchar (key_character, 1, 1);
-              }
-              gpio_put(ONBOARD_LED,1);
-              macro_raise_pressed = 0;
-              sleep_ms(10);
-              update_neopixels();              
-        }}        
-        if (macro_spindle_pressed){
-          if (gpio_get(SPINDLEBUTTON)){}//button is still pressed, do nothing
-          else{
-            key_character = MACROSPINDLE;
-            keypad_sendchar (key_character, 1, 1);
-            gpio_put(ONBOARD_LED,1);
-            macro_spindle_pressed = 0;
-            sleep_ms(10);
-            update_neopixels();
-        }}
-        if (macro_home_pressed){
-          if (gpio_get(HOMEBUTTON)){}//button is still pressed, do nothing
-          else{
-            key_character = MACROHOME;
-            keypad_sendchar (key_character, 1, 1);
-            gpio_put(ONBOARD_LED,1);
-            macro_home_pressed = 0;
-            sleep_ms(10);
-            update_neopixels();
-        }}
-        if (reset_pressed){
-          if (gpio_get(HOLDBUTTON)){}//button is still pressed, do nothing
-          else{
-            key_character = RESET;
-            keypad_sendchar (key_character, 1, 1);
-            gpio_put(ONBOARD_LED,1);
-            reset_pressed = 0;
-            sleep_ms(10);
-            packet->system_state = SystemState_Undefined;
-            packet->status_code = Status_Reset;
-            draw_main_screen(1);
-            sleep_ms(500);            
-            update_neopixels();
-        }}
-        if (unlock_pressed){
-          if (gpio_get(RUNBUTTON)){}//button is still pressed, do nothing
-          else{
-            key_character = UNLOCK;
-            keypad_sendchar (key_character, 1, 1);
-            gpio_put(ONBOARD_LED,1);
-            unlock_pressed = 0;
-            sleep_ms(10);
-            update_neopixels();
-        }}
-        if (feed_down_fine_pressed) {
-          if (gpio_get(FEEDOVER_DOWN)){}//button is still pressed, do nothing
-          else{
-            key_character = CMD_OVERRIDE_FEED_FINE_MINUS;
-            keypad_sendchar (key_character, 1, 1);
-            gpio_put(ONBOARD_LED,1);
-            feed_down_fine_pressed = 0;
-            sleep_ms(10);
-            update_neopixels();                       
-         }}
-        if (feed_up_fine_pressed) {
-          if (gpio_get(FEEDOVER_UP)){}//button is still pressed, do nothing
-          else{
-            key_character = CMD_OVERRIDE_FEED_FINE_PLUS;
-            keypad_sendchar (key_character, 1, 1);
-            gpio_put(ONBOARD_LED,1);
-            feed_up_fine_pressed = 0;
-            sleep_ms(10);
-            update_neopixels();                
-        }}
-        if (spin_down_fine_pressed) {
-          if (gpio_get(SPINOVER_DOWN)){}//button is still pressed, do nothing
-          else{
-            key_character = CMD_OVERRIDE_SPINDLE_FINE_MINUS;
-            keypad_sendchar (key_character, 1, 1);
-            gpio_put(ONBOARD_LED,1);
-            spin_down_fine_pressed = 0;
-            sleep_ms(10);
-            update_neopixels();           
-        }}
-        if (spin_up_fine_pressed) {
-          if (gpio_get(SPINOVER_UP)){}//button is still pressed, do nothing
-          else{
-            key_character = CMD_OVERRIDE_SPINDLE_FINE_PLUS;
-            keypad_sendchar (key_character, 1, 1);
-            gpio_put(ONBOARD_LED,1);
-            spin_up_fine_pressed = 0;
-            sleep_ms(10);
-            update_neopixels();
-        }}  
-        if (halt_pressed){
-          if (gpio_get(HALTBUTTON)){
-            pixels.setPixelColor(HALTLED,pixels.Color(0,255,0));
-            pixels.show();
-          }//button is still pressed, do nothing
-          else{
-            //erase and write memory location based on current value of screenflip.
-            
-            pixels.setPixelColor(HALTLED,pixels.Color(255,255,0));
-            pixels.show();
-            sleep_ms(250);
-            screenflip = !screenflip;
-            uint32_t status = save_and_disable_interrupts();
-            flash_range_erase(FLASH_TARGET_OFFSET, FLASH_SECTOR_SIZE);
-            
-            restore_interrupts(status);
-            sleep_ms(250);
-            flash_range_program(FLASH_TARGET_OFFSET, (uint8_t*)&screenflip, 1);
-            halt_pressed = 0;
-            //update_neopixels();
-
-            #define AIRCR_Register (*((volatile uint32_t*)(PPB_BASE + 0x0ED0C)))
-
-            AIRCR_Register = 0x5FA0004;
-        }}                                                                                                                                                  
     }//close main while loop
     return 0;
 }
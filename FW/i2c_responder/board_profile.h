@@ -0,0 +1,187 @@
+#ifndef __BOARD_PROFILE_H__
+#define __BOARD_PROFILE_H__
+
+#include <stdint.h>
+
+// Board revisions. Pick one with -DJOG2K_BOARD=JOG2K_BOARD_xx (CMake does this
+// for every firmware target it generates).
+#define JOG2K_BOARD_A5   1 // Pi Pico based carrier board
+#define JOG2K_BOARD_A6   2 // discrete RP2040 board
+#define JOG2K_BOARD_SLIM 3 // Jog2K Slim mod, 1.3" SH1106 OLED on the front panel
+
+#ifndef JOG2K_BOARD
+#define JOG2K_BOARD JOG2K_BOARD_A6
+#endif
+
+// Every button on the keypad. The order here is the order used by the
+// input scanner, it has nothing to do with the GPIO numbers.
+typedef enum {
+    BUTTON_HALT = 0,
+    BUTTON_RUN,
+    BUTTON_HOLD,
+    BUTTON_JOG_SELECT,
+    BUTTON_UP,
+    BUTTON_DOWN,
+    BUTTON_LEFT,
+    BUTTON_RIGHT,
+    BUTTON_LOWER,
+    BUTTON_RAISE,
+    BUTTON_FEEDOVER_UP,
+    BUTTON_FEEDOVER_DOWN,
+    BUTTON_FEEDOVER_RESET,
+    BUTTON_SPINOVER_UP,
+    BUTTON_SPINOVER_DOWN,
+    BUTTON_SPINOVER_RESET,
+    BUTTON_SPINDLE,
+    BUTTON_FLOOD,
+    BUTTON_MIST,
+    BUTTON_HOME,
+    BUTTON_COUNT
+} board_button_t;
+
+// Every NeoPixel with a fixed meaning.
+typedef enum {
+    LED_RAISE = 0,
+    LED_JOG,
+    LED_SPIN,
+    LED_FEED,
+    LED_HALT,
+    LED_HOLD,
+    LED_RUN,
+    LED_SPINDLE,
+    LED_COOLANT,
+    LED_HOME,
+    LED_COUNT
+} board_led_t;
+
+typedef struct {
+    const char *name;
+    uint8_t button[BUTTON_COUNT]; // GPIO of each button, indexed by board_button_t
+    uint8_t led[LED_COUNT];       // NeoPixel chain index of each LED, indexed by board_led_t
+    uint8_t num_pixels;           // length of the NeoPixel chain
+    uint8_t neopixel_pin;
+    uint8_t kpstr_pin;            // keypad strobe to the controller
+    uint8_t onboard_led_pin;
+    uint8_t slave_sda_pin, slave_scl_pin; // I2C0, link to the controller
+    uint8_t oled_sda_pin, oled_scl_pin;   // OLED bus
+    int8_t oled_reset_pin;                // -1 = not connected
+    uint8_t oled_type;                    // one of the OLED_xxx types from ss_oled.h
+    uint8_t oled_bus;                     // one of the I2C_BACKEND_xxx values from BitBang_I2C.h
+} board_profile_t;
+
+// OLED types, mirrored from ss_oled.h so this header stays standalone
+#define BOARD_OLED_128x64 3
+#define BOARD_OLED_132x64 4
+
+// OLED bus backends, mirrored from BitBang_I2C.h
+#define BOARD_OLED_BUS_BITBANG 0
+#define BOARD_OLED_BUS_HW_DMA  2 // needs an I2C capable SDA/SCL pair
+#define BOARD_OLED_BUS_PIO_DMA 3 // any pins, SCL = SDA + 1
+
+// What the A5, A6 and Slim boards have in common, which today is everything
+// but the OLED that is fitted. A board overrides what differs in
+// board_variant() below.
+static constexpr board_profile_t board_base = {
+    "base",
+    {
+        5,  /* BUTTON_HALT */
+        20, /* BUTTON_RUN */
+        19, /* BUTTON_HOLD */
+        14, /* BUTTON_JOG_SELECT */
+        6,  /* BUTTON_UP */
+        7,  /* BUTTON_DOWN */
+        8,  /* BUTTON_LEFT */
+        9,  /* BUTTON_RIGHT */
+        10, /* BUTTON_LOWER */
+        11, /* BUTTON_RAISE */
+        4,  /* BUTTON_FEEDOVER_UP */
+        12, /* BUTTON_FEEDOVER_DOWN */
+        13, /* BUTTON_FEEDOVER_RESET */
+        15, /* BUTTON_SPINOVER_UP */
+        16, /* BUTTON_SPINOVER_DOWN */
+        26, /* BUTTON_SPINOVER_RESET */
+        21, /* BUTTON_SPINDLE */
+        17, /* BUTTON_FLOOD */
+        18, /* BUTTON_MIST */
+        27  /* BUTTON_HOME */
+    },
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }, // LEDs, the chain is wired in board_led_t order
+    10,     // num_pixels
+    22,     // neopixel_pin
+    28,     // kpstr_pin
+    25,     // onboard_led_pin
+    0, 1,   // slave_sda_pin, slave_scl_pin
+    2, 3,   // oled_sda_pin, oled_scl_pin
+    -1,     // oled_reset_pin
+    BOARD_OLED_128x64,
+    BOARD_OLED_BUS_HW_DMA
+};
+
+// The base with the name and the OLED of one board
+constexpr board_profile_t board_variant(const char *name, uint8_t oled_type)
+{
+    board_profile_t b = board_base;
+    b.name = name;
+    b.oled_type = oled_type;
+    return b;
+}
+
+#if JOG2K_BOARD == JOG2K_BOARD_A5
+static constexpr board_profile_t board = board_variant("A5", BOARD_OLED_128x64);
+#elif JOG2K_BOARD == JOG2K_BOARD_A6
+static constexpr board_profile_t board = board_variant("A6", BOARD_OLED_128x64);
+#elif JOG2K_BOARD == JOG2K_BOARD_SLIM
+static constexpr board_profile_t board = board_variant("Slim", BOARD_OLED_132x64);
+#else
+#error "Unknown JOG2K_BOARD"
+#endif
+
+//
+// Everything below is derived from the profile at compile time
+//
+constexpr uint32_t board_input_mask(const board_profile_t &b)
+{
+    uint32_t mask = 0;
+    for (int i = 0; i < BUTTON_COUNT; i++)
+        mask |= 1u << b.button[i];
+    return mask;
+}
+
+constexpr uint32_t board_output_mask(const board_profile_t &b)
+{
+    return (1u << b.kpstr_pin) | (1u << b.onboard_led_pin);
+}
+
+constexpr uint32_t board_bus_mask(const board_profile_t &b)
+{
+    return (1u << b.slave_sda_pin) | (1u << b.slave_scl_pin) |
+           (1u << b.oled_sda_pin) | (1u << b.oled_scl_pin) | (1u << b.neopixel_pin);
+}
+
+constexpr int board_popcount(uint32_t v)
+{
+    int n = 0;
+    for (; v; v &= v - 1)
+        n++;
+    return n;
+}
+
+static constexpr uint32_t BOARD_INPUT_MASK = board_input_mask(board);
+static constexpr uint32_t BOARD_OUTPUT_MASK = board_output_mask(board);
+
+static_assert(board_popcount(BOARD_INPUT_MASK) == BUTTON_COUNT, "two buttons share a GPIO");
+static_assert((BOARD_INPUT_MASK & BOARD_OUTPUT_MASK) == 0, "button GPIO also used as an output");
+static_assert(((BOARD_INPUT_MASK | BOARD_OUTPUT_MASK) & board_bus_mask(board)) == 0, "button/output GPIO collides with a bus pin");
+// I2C0 carries the link to the controller, the OLED can only have the other block
+static_assert(board.oled_bus != BOARD_OLED_BUS_HW_DMA ||
+              (((board.oled_sda_pin >> 1) & 1) == 1 && (board.oled_sda_pin & 1) == 0 && board.oled_scl_pin == board.oled_sda_pin + 1),
+              "hardware OLED bus needs an I2C1 SDA/SCL pin pair");
+static_assert(board.oled_bus != BOARD_OLED_BUS_PIO_DMA || board.oled_scl_pin == board.oled_sda_pin + 1,
+              "PIO OLED bus needs SCL on the pin after SDA");
+
+// Bit of a GPIO in a gpio_get_all() snapshot
+#define GPIO_BIT(pin) (1u << (pin))
+// Test a pin in a snapshot taken by the input scanner
+#define BUTTON_DOWN(inputs, pin) (((inputs) & GPIO_BIT(pin)) != 0)
+
+#endif // __BOARD_PROFILE_H__
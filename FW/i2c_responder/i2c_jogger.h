@@ -10,10 +10,12 @@
 
 #define JOG2K_VERSION "v" JOG2K_FW_VERSION "+" BUILD_SHA
 
+#include "board_profile.h"
+
 // Which pin on the Arduino is connected to the NeoPixels?
-#define PIN        22 // On Trinket or Gemma, suggest changing this to 1
+#define PIN        board.neopixel_pin
 // How many NeoPixels are attached to the Arduino?
-#define NUMPIXELS 10 // Popular NeoPixel ring size
+#define NUMPIXELS  board.num_pixels
 #define DELAYVAL 200 // Time (in milliseconds) to pause between pixels
 #define CYCLEDELAY 12 // Time to wait after a cycle
 #define NEO_BRIGHTNESS 128
@@ -22,9 +24,9 @@
 #define FLASH_TARGET_OFFSET (256 * 1024)
 const uint8_t *flash_target_contents = (const uint8_t *) (XIP_BASE + FLASH_TARGET_OFFSET);
 
-#define SDA_PIN 2
-#define SCL_PIN 3
-#define RESET_PIN -1
+#define SDA_PIN board.oled_sda_pin
+#define SCL_PIN board.oled_scl_pin
+#define RESET_PIN board.oled_reset_pin
 
 // #define STATE_ALARM         1 //!< In alarm state. Locks out all g-code processes. Allows settings access.
 // #define STATE_CYCLE         2 //!< Cycle is running or motions are being executed.
@@ -54,46 +56,47 @@ const uint8_t *flash_target_contents = (const uint8_t *) (XIP_BASE + FLASH_TARGE
 #define OLED_WIDTH 128
 #define OLED_HEIGHT 64
 
-//neopixel led locations
-#define RAISELED 0
-#define JOGLED 1
-#define SPINLED 2
-#define FEEDLED 3
-#define HALTLED 4
-#define HOLDLED 5
-#define RUNLED 6
-#define SPINDLELED 7
-#define COOLED 8
-#define HOMELED 9
-
-#define KPSTR_PIN 28
-
-#define HALTBUTTON 5
-#define RUNBUTTON 20
-#define HOLDBUTTON 19
-
-#define JOG_SELECT 14
-#define UPBUTTON 6
-#define DOWNBUTTON 7
-#define LEFTBUTTON 8
-#define RIGHTBUTTON 9
-#define LOWERBUTTON 10
-#define RAISEBUTTON 11
-
-#define FEEDOVER_UP 4
-#define FEEDOVER_DOWN 12
-#define FEEDOVER_RESET 13
-
-#define SPINOVER_UP 15
-#define SPINOVER_DOWN 16
-#define SPINOVER_RESET 26
-
-#define SPINDLEBUTTON 21
-#define FLOODBUTTON 17
-#define MISTBUTTON 18
-#define HOMEBUTTON 27
-
-#define ONBOARD_LED 25
+//neopixel led locations, see board_profile.h
+#define RAISELED board.led[LED_RAISE]
+#define JOGLED board.led[LED_JOG]
+#define SPINLED board.led[LED_SPIN]
+#define FEEDLED board.led[LED_FEED]
+#define HALTLED board.led[LED_HALT]
+#define HOLDLED board.led[LED_HOLD]
+#define RUNLED board.led[LED_RUN]
+#define SPINDLELED board.led[LED_SPINDLE]
+#define COOLED board.led[LED_COOLANT]
+#define HOMELED board.led[LED_HOME]
+
+//button and strobe GPIOs, see board_profile.h
+#define KPSTR_PIN board.kpstr_pin
+
+#define HALTBUTTON board.button[BUTTON_HALT]
+#define RUNBUTTON board.button[BUTTON_RUN]
+#define HOLDBUTTON board.button[BUTTON_HOLD]
+
+#define JOG_SELECT board.button[BUTTON_JOG_SELECT]
+#define UPBUTTON board.button[BUTTON_UP]
+#define DOWNBUTTON board.button[BUTTON_DOWN]
+#define LEFTBUTTON board.button[BUTTON_LEFT]
+#define RIGHTBUTTON board.button[BUTTON_RIGHT]
+#define LOWERBUTTON board.button[BUTTON_LOWER]
+#define RAISEBUTTON board.button[BUTTON_RAISE]
+
+#define FEEDOVER_UP board.button[BUTTON_FEEDOVER_UP]
+#define FEEDOVER_DOWN board.button[BUTTON_FEEDOVER_DOWN]
+#define FEEDOVER_RESET board.button[BUTTON_FEEDOVER_RESET]
+
+#define SPINOVER_UP board.button[BUTTON_SPINOVER_UP]
+#define SPINOVER_DOWN board.button[BUTTON_SPINOVER_DOWN]
+#define SPINOVER_RESET board.button[BUTTON_SPINOVER_RESET]
+
+#define SPINDLEBUTTON board.button[BUTTON_SPINDLE]
+#define FLOODBUTTON board.button[BUTTON_FLOOD]
+#define MISTBUTTON board.button[BUTTON_MIST]
+#define HOMEBUTTON board.button[BUTTON_HOME]
+
+#define ONBOARD_LED board.onboard_led_pin
 
 #define LED_UPDATE_PERIOD 10
 #define KEYPAD_UPDATE_PERIOD 10
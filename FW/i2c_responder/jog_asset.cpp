@@ -0,0 +1,49 @@
+//
+// Packed flash assets, see jog_asset.h. The decoder itself is in
+// jog_asset_unpack.cpp.
+//
+#include "jog_display.h"
+#include "jog_asset.h"
+
+void asset_draw(const asset_bitmap_t *bitmap, int x, int page, bool invert)
+{
+    int rows = display_height() / 8 - page;
+
+    if (x < 0 || page < 0 || x >= display_width() || rows <= 0)
+        return;
+    asset_unpack(bitmap->ops, bitmap->size, bitmap->width, bitmap->pages, display_row(page) + x,
+                 rows > 1 ? (int)(display_row(page + 1) - display_row(page)) : 0, display_width() - x, rows,
+                 invert ? 0xff : 0);
+} /* asset_draw() */
+
+// The cache: the glyph in each slot and when it was last used
+static const asset_font_t *glyph_font[ASSET_GLYPH_CACHE];
+static uint8_t glyph_code[ASSET_GLYPH_CACHE];
+static uint32_t glyph_used[ASSET_GLYPH_CACHE];
+static uint32_t u32GlyphClock;
+static uint8_t glyph_bytes[ASSET_GLYPH_CACHE][ASSET_GLYPH_MAX];
+
+const uint8_t *asset_glyph(const asset_font_t *font, int code)
+{
+    int slot = 0, size = font->width * font->pages;
+
+    if (code < font->first || code > font->last)
+        code = font->first;
+    for (int i = 0; i < ASSET_GLYPH_CACHE; i++) {
+        if (glyph_font[i] == font && glyph_code[i] == code) {
+            glyph_used[i] = ++u32GlyphClock;
+            return glyph_bytes[i];
+        }
+        if (glyph_used[i] < glyph_used[slot])
+            slot = i; // least recently used, a free slot is 0
+    }
+    if (size > ASSET_GLYPH_MAX)
+        size = ASSET_GLYPH_MAX; // can't happen with the fonts fontc packs
+    asset_unpack(&font->ops[font->index[code - font->first]],
+                 font->index[code - font->first + 1] - font->index[code - font->first], font->width, font->pages,
+                 glyph_bytes[slot], font->width, font->width, size / font->width, 0);
+    glyph_font[slot] = font;
+    glyph_code[slot] = code;
+    glyph_used[slot] = ++u32GlyphClock;
+    return glyph_bytes[slot];
+} /* asset_glyph() */
@@ -0,0 +1,57 @@
+#ifndef __JOG_ASSET_H__
+#define __JOG_ASSET_H__
+//
+// Packed flash assets
+//
+// Large fonts, the splash and icons are kept in flash as an opcode stream
+// made by tools/fontc.cpp instead of raw bytes. The stream codes the bytes
+// in SSD1306 order (width bytes per 8 pixel page row, bit 0 at the top)
+// with the run-length scheme of oledPlayAnimFrame(), the one difference
+// being that a skip writes blank bytes:
+//
+//   00sssccc           skip s, then copy the c bytes that follow (s or c > 0)
+//   00000000 n         skip n + 1
+//   01cccsss           copy the c bytes that follow, then skip s (c or s > 0)
+//   01000000 n         copy the n + 1 bytes that follow
+//   10rrrsss b         repeat b r times, then skip s
+//   11rrrrrr b         repeat b r + 1 times
+//
+// A bitmap or glyph the opcodes would not make smaller is stored raw, as
+// its width * pages bytes. That is the one length a packed stream never
+// has, so the length alone tells the two apart.
+//
+// A bitmap is drawn by decoding it straight into the back buffer. A glyph
+// of a packed font is decoded into a small cache of recent glyphs first,
+// and drawn from there like any glyph in a plain table.
+//
+#include <stdint.h>
+
+#define ASSET_GLYPH_CACHE 8  // glyphs kept decoded
+#define ASSET_GLYPH_MAX 64   // bytes of the largest packed glyph, 16x32
+
+typedef struct {
+    const uint8_t *ops;
+    uint16_t size;  // bytes of ops, width * pages when stored raw
+    uint8_t width;  // pixels
+    uint8_t pages;  // page rows
+} asset_bitmap_t;
+
+typedef struct {
+    const uint8_t *ops;
+    const uint16_t *index; // where each glyph starts in ops, then the end
+    uint8_t width, pages;  // of every glyph
+    uint8_t first, last;   // character codes
+} asset_font_t;
+
+// Decode the len bytes at ops (width x pages) to dst, page row r at
+// dst + r * pitch. Only the first cols columns and rows page rows are
+// written, the rest is clipped. Every byte is XORed with invert (0 or 0xff).
+void asset_unpack(const uint8_t *ops, int len, int width, int pages, uint8_t *dst, int pitch, int cols, int rows,
+                  uint8_t invert);
+// Draw a bitmap into the back buffer at x, page, clipped to the display
+void asset_draw(const asset_bitmap_t *bitmap, int x, int page, bool invert);
+// The glyph for code in plain table order (width bytes per page row), from
+// the cache. Codes outside the font give the first glyph.
+const uint8_t *asset_glyph(const asset_font_t *font, int code);
+
+#endif // __JOG_ASSET_H__
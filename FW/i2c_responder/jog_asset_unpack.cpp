@@ -0,0 +1,116 @@
+//
+// Decoder of the packed asset stream, see jog_asset.h
+//
+// Nothing here touches the display or the SDK: tools/ builds this file into
+// fontc too, which decodes every stream it packs to check the round trip.
+//
+#include <string.h>
+
+#include "jog_asset.h"
+
+#define OP_MASK 0xc0
+#define OP_SKIPCOPY 0x00
+#define OP_COPYSKIP 0x40
+#define OP_REPEATSKIP 0x80
+#define OP_REPEAT 0xc0
+
+// Where the decoded bytes go
+typedef struct {
+    uint8_t *dst;
+    int pitch, width, cols, rows;
+    int col, row; // next byte
+    uint8_t invert;
+} asset_out_t;
+
+// Write iLen bytes, from pSrc or b repeated when pSrc is NULL
+static void asset_put(asset_out_t *o, const uint8_t *pSrc, uint8_t b, int iLen)
+{
+    while (iLen > 0) {
+        int n = o->width - o->col; // to the end of the page row
+
+        if (n > iLen)
+            n = iLen;
+        if (o->row < o->rows && o->col < o->cols) {
+            int vis = o->cols - o->col < n ? o->cols - o->col : n;
+            uint8_t *d = &o->dst[o->row * o->pitch + o->col];
+            if (pSrc)
+                for (int i = 0; i < vis; i++)
+                    d[i] = pSrc[i] ^ o->invert;
+            else
+                memset(d, b ^ o->invert, vis);
+        }
+        if (pSrc)
+            pSrc += n;
+        iLen -= n;
+        o->col += n;
+        if (o->col == o->width) {
+            o->col = 0;
+            o->row++;
+        }
+    }
+} /* asset_put() */
+
+void asset_unpack(const uint8_t *ops, int len, int width, int pages, uint8_t *dst, int pitch, int cols, int rows,
+                  uint8_t invert)
+{
+    asset_out_t o = {dst, pitch, width, cols < width ? cols : width, rows < pages ? rows : pages, 0, 0, invert};
+    const uint8_t *s = ops;
+    int i = 0, iSize = width * pages, j;
+    uint8_t bCode, b;
+
+    if (len == iSize) { // stored raw
+        asset_put(&o, ops, 0, len);
+        return;
+    }
+    while (i < iSize) {
+        bCode = *s++;
+        switch (bCode & OP_MASK) {
+            case OP_SKIPCOPY:
+                if (bCode == OP_SKIPCOPY) { // big skip
+                    j = *s++ + 1;
+                    asset_put(&o, NULL, 0, j);
+                    i += j;
+                } else {
+                    j = (bCode & 0x38) >> 3;
+                    asset_put(&o, NULL, 0, j);
+                    i += j;
+                    j = bCode & 7;
+                    asset_put(&o, s, 0, j);
+                    s += j;
+                    i += j;
+                }
+                break;
+            case OP_COPYSKIP:
+                if (bCode == OP_COPYSKIP) { // big copy
+                    j = *s++ + 1;
+                    asset_put(&o, s, 0, j);
+                    s += j;
+                    i += j;
+                } else {
+                    j = (bCode & 0x38) >> 3;
+                    asset_put(&o, s, 0, j);
+                    s += j;
+                    i += j;
+                    j = bCode & 7;
+                    asset_put(&o, NULL, 0, j);
+                    i += j;
+                }
+                break;
+            case OP_REPEATSKIP:
+                j = (bCode & 0x38) >> 3;
+                b = *s++;
+                asset_put(&o, NULL, b, j);
+                i += j;
+                j = bCode & 7;
+                asset_put(&o, NULL, 0, j);
+                i += j;
+                break;
+            case OP_REPEAT:
+                j = (bCode & 0x3f) + 1;
+                b = *s++;
+                asset_put(&o, NULL, b, j);
+                i += j;
+                break;
+        }
+    }
+} /* asset_unpack() */
@@ -0,0 +1,74 @@
+#ifndef __JOG_DISPLAY_H__
+#define __JOG_DISPLAY_H__
+//
+// Display backend
+//
+// The screen code draws through these calls and never sees the library
+// behind them. Which one is picked at build time (cmake -DJOG2K_DISPLAY=):
+// jog_display_ssoled.cpp drives the panel with ss_oled, the default, and
+// jog_display_obd.cpp with OneBitDisplay, which knows many more controllers
+// (SH1107, UC1701, ST7302, Sharp memory LCDs, ...) and GFX fonts.
+//
+// Both backends work the same way. Drawing only touches the back buffer,
+// kept in SSD1306 page order (width bytes per 8 pixel row, bit 0 at the
+// top). display_flush() sends what differs from the shadow copy of the
+// panel, only queued on the DMA buses, and display_frame_done() tells when
+// it has left the bus. On the blocking bit-bang bus display_flush_row()
+// sends one page row at a time instead.
+//
+// FONT_xxx and the OLED_xxx panel types come from the backend header. The
+// five fixed fonts and the panels in board_profile.h have the same values
+// in both libraries.
+//
+#include <stdint.h>
+
+#include "BitBang_I2C.h"
+#if JOG2K_DISPLAY_OBD
+#include "OneBitDisplay.h"
+#else
+#include "ss_oled.h"
+#endif
+
+#ifndef DISPLAY_BUFFER_SIZE
+#define DISPLAY_BUFFER_SIZE 1024 // back buffer and shadow each, 128x64
+#endif
+
+// Set up the panel at I2C address 0x3c on the given bus (I2C_BACKEND_xxx).
+// Returns what the backend found, OLED_NOT_FOUND if nothing answered or the
+// panel does not fit in DISPLAY_BUFFER_SIZE.
+int display_init(int type, bool flip, int bus, int sda_pin, int scl_pin, int reset_pin, int32_t bus_hz);
+const char *display_name(void);
+int display_width(void);
+int display_height(void);
+// The bus the panel is on, for the bus benchmark
+BBI2C *display_bus(void);
+
+// Back buffer drawing. x and the rectangle are in pixels, text sits on a
+// page row (8 pixel lines) in one of the fixed fonts.
+void display_fill(uint8_t pattern);
+void display_text(int x, int page, const char *text, int font, bool invert);
+void display_rect(int x1, int y1, int x2, int y2, bool lit, bool filled);
+// The back buffer bytes of page row page, display_width() of them
+uint8_t *display_row(int page);
+
+// Forget what the panel shows, the next flush sends every byte
+void display_invalidate(void);
+// Send the changes, returns the number of bytes put on the bus
+int display_flush(void);
+// The same for page row page only, -1 before the first display_flush()
+int display_flush_row(int page);
+// Whether the frame is better sent with display_flush_row(), one row per
+// render unit: the bus blocks while it sends and the shadow is in sync
+bool display_flush_by_row(void);
+// true once everything sent by the last flush has gone to the controller
+bool display_frame_done(void);
+// Send the whole back buffer, whatever the panel shows, returns the bytes
+int display_dump(void);
+// Start or stop the controller scrolling page row page to the left on its
+// own (SSD1306 continuous horizontal scroll). The row must already be on
+// the panel and must not change while it scrolls. Stopping calls
+// display_invalidate(), the controller RAM has to be sent again.
+// Returns false if the panel can't.
+bool display_scroll(int page, bool on);
+
+#endif // __JOG_DISPLAY_H__
@@ -0,0 +1,184 @@
+//
+// Display backend on OneBitDisplay, see jog_display.h
+//
+// OneBitDisplay has no shadow buffer, so the diff that ss_oled does in
+// oledFlush() is done here: one run of changed columns per page row, sent
+// with obdSetPosition()/obdWriteDataBlock() on the same BitBang_I2C bus, and
+// the frame is fenced the same way. Panels that are not page addressed
+// (ST7302, Sharp memory LCDs, e-paper) get the whole buffer from
+// obdDumpBuffer() every frame.
+//
+#include <string.h>
+
+#include "pico/stdlib.h"
+
+#include "jog_display.h"
+
+static_assert(FONT_6x8 == 0 && FONT_8x8 == 1 && FONT_12x16 == 2 && FONT_16x16 == 3 && FONT_16x32 == 4,
+              "jog_widget.cpp sizes its boxes by the ss_oled font order");
+
+static OBDISP obd;
+static uint8_t ucBuffer[DISPLAY_BUFFER_SIZE];
+static uint8_t ucShadow[DISPLAY_BUFFER_SIZE]; // what the panel shows
+static bool bShadowValid;
+static volatile bool bFramePending;
+
+static bool display_paged(void)
+{
+    return obd.type < SHARP_144x168;
+} /* display_paged() */
+
+static void display_frame_sent(void *pUser, int bOK)
+{
+    (void)pUser;
+    (void)bOK;
+    bFramePending = false;
+} /* display_frame_sent() */
+
+int display_init(int type, bool flip, int bus, int sda_pin, int scl_pin, int reset_pin, int32_t bus_hz)
+{
+    int rc = obdI2CInit(&obd, type, 0x3c, flip, 0, bus, sda_pin, scl_pin, reset_pin, bus_hz);
+
+    if (obd.width * ((obd.height + 7) / 8) > DISPLAY_BUFFER_SIZE)
+        return OLED_NOT_FOUND;
+    obdSetBackBuffer(&obd, ucBuffer);
+    bShadowValid = false;
+    bFramePending = false;
+    return rc;
+} /* display_init() */
+
+const char *display_name(void)
+{
+    return "obd";
+} /* display_name() */
+
+int display_width(void)
+{
+    return obd.width;
+} /* display_width() */
+
+int display_height(void)
+{
+    return obd.height;
+} /* display_height() */
+
+BBI2C *display_bus(void)
+{
+    return &obd.bbi2c;
+} /* display_bus() */
+
+void display_fill(uint8_t pattern)
+{
+    obdFill(&obd, pattern, 0);
+} /* display_fill() */
+
+void display_text(int x, int page, const char *text, int font, bool invert)
+{
+    obdWriteString(&obd, 0, x, page * 8, (char *)text, font, invert ? OBD_WHITE : OBD_BLACK, 0);
+} /* display_text() */
+
+void display_rect(int x1, int y1, int x2, int y2, bool lit, bool filled)
+{
+    obdRectangle(&obd, x1, y1, x2, y2, lit ? OBD_BLACK : OBD_WHITE, filled);
+} /* display_rect() */
+
+uint8_t *display_row(int page)
+{
+    return &ucBuffer[page * obd.width];
+} /* display_row() */
+
+void display_invalidate(void)
+{
+    bShadowValid = false;
+} /* display_invalidate() */
+
+// Send the changed columns of one page row (all of them with bAll), returns
+// the bytes for the position command and the data
+static int display_send_page(int page, bool bAll)
+{
+    uint8_t *pSrc = &ucBuffer[page * obd.width], *pShadow = &ucShadow[page * obd.width], *pScreen;
+    int x1 = 0, x2 = obd.width - 1;
+
+    if (!bAll)
+    {
+        while (x1 <= x2 && pSrc[x1] == pShadow[x1])
+            x1++;
+        if (x1 > x2)
+            return 0;
+        while (pSrc[x2] == pShadow[x2])
+            x2--;
+    }
+    pScreen = obd.ucScreen; // the data is in there already, don't copy it onto itself
+    obd.ucScreen = NULL;
+    obdSetPosition(&obd, x1, page * 8, 1);
+    obdWriteDataBlock(&obd, &pSrc[x1], x2 - x1 + 1, 1);
+    obd.ucScreen = pScreen;
+    memcpy(&pShadow[x1], &pSrc[x1], x2 - x1 + 1);
+    return 5 + x2 - x1 + 1;
+} /* display_send_page() */
+
+int display_flush(void)
+{
+    int bytes = 0;
+
+    if (!display_paged())
+    {
+        obdDumpBuffer(&obd, NULL);
+        bytes = obd.width * ((obd.height + 7) / 8);
+    }
+    else
+    {
+        for (int page = 0; page < (obd.height + 7) / 8; page++)
+            bytes += display_send_page(page, !bShadowValid);
+        bShadowValid = true;
+    }
+    if (bytes)
+    {
+        bFramePending = true; // before the fence, it can fire right away
+        I2CFence(&obd.bbi2c, display_frame_sent, NULL);
+    }
+    return bytes;
+} /* display_flush() */
+
+int display_flush_row(int page)
+{
+    if (!bShadowValid || !display_paged())
+        return -1;
+    return display_send_page(page, false);
+} /* display_flush_row() */
+
+bool display_flush_by_row(void)
+{
+    return obd.bbi2c.bWire == I2C_BACKEND_BITBANG && bShadowValid && display_paged();
+} /* display_flush_by_row() */
+
+bool display_frame_done(void)
+{
+    return !bFramePending;
+} /* display_frame_done() */
+
+int display_dump(void)
+{
+    obdDumpBuffer(&obd, NULL);
+    display_invalidate();
+    return obd.width * ((obd.height + 7) / 8);
+} /* display_dump() */
+
+// OneBitDisplay has no call for it, the SSD1306 commands go out one by one
+bool display_scroll(int page, bool on)
+{
+    // left, dummy, start page, a step every 5 frames, end page, dummy, dummy
+    uint8_t ucSetup[] = {0x27, 0x00, (uint8_t)page, 0x00, (uint8_t)page, 0x00, 0xff, 0x2f};
+
+    if (obd.type != OLED_128x64 && obd.type != OLED_128x32) // SH1106 shows up as OLED_132x64
+        return false;
+    obdWriteCommand(&obd, 0x2e);
+    if (!on)
+    {
+        display_invalidate();
+        return true;
+    }
+    for (unsigned i = 0; i < sizeof(ucSetup); i++)
+        obdWriteCommand(&obd, ucSetup[i]);
+    return true;
+} /* display_scroll() */
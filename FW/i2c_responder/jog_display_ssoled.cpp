@@ -0,0 +1,104 @@
+//
+// Display backend on ss_oled, see jog_display.h
+//
+#include "pico/stdlib.h"
+
+#include "jog_display.h"
+
+static SSOLED oled;
+static uint8_t ucBuffer[DISPLAY_BUFFER_SIZE];
+static uint8_t ucShadow[DISPLAY_BUFFER_SIZE]; // what the panel shows, see oledFlush()
+
+int display_init(int type, bool flip, int bus, int sda_pin, int scl_pin, int reset_pin, int32_t bus_hz)
+{
+    int rc = oledInit(&oled, type, 0x3c, flip, 0, bus, sda_pin, scl_pin, reset_pin, bus_hz);
+
+    if (oled.oled_x > 128 || 128 * (oled.oled_y / 8) > DISPLAY_BUFFER_SIZE)
+        return OLED_NOT_FOUND; // the back buffer stride is 128, a 128x128 panel does not fit
+    oledSetBackBuffer(&oled, ucBuffer); // ss_oled always uses a 128 byte stride
+    oledSetShadowBuffer(&oled, ucShadow);
+    return rc;
+} /* display_init() */
+
+const char *display_name(void)
+{
+    return "ss_oled";
+} /* display_name() */
+
+int display_width(void)
+{
+    return oled.oled_x;
+} /* display_width() */
+
+int display_height(void)
+{
+    return oled.oled_y;
+} /* display_height() */
+
+BBI2C *display_bus(void)
+{
+    return &oled.bbi2c;
+} /* display_bus() */
+
+void display_fill(uint8_t pattern)
+{
+    oledFill(&oled, pattern, 0);
+} /* display_fill() */
+
+void display_text(int x, int page, const char *text, int font, bool invert)
+{
+    oledWriteString(&oled, 0, x, page, (char *)text, font, invert, 0);
+} /* display_text() */
+
+void display_rect(int x1, int y1, int x2, int y2, bool lit, bool filled)
+{
+    oledRectangle(&oled, x1, y1, x2, y2, lit, filled);
+} /* display_rect() */
+
+uint8_t *display_row(int page)
+{
+    return &ucBuffer[page * 128];
+} /* display_row() */
+
+void display_invalidate(void)
+{
+    oledSetShadowBuffer(&oled, ucShadow);
+} /* display_invalidate() */
+
+int display_flush(void)
+{
+    return oledFlush(&oled);
+} /* display_flush() */
+
+int display_flush_row(int page)
+{
+    return oledFlushRow(&oled, page);
+} /* display_flush_row() */
+
+bool display_flush_by_row(void)
+{
+    return oled.bbi2c.bWire == I2C_BACKEND_BITBANG && oled.bShadowValid;
+} /* display_flush_by_row() */
+
+bool display_frame_done(void)
+{
+    return oledFrameDone(&oled);
+} /* display_frame_done() */
+
+int display_dump(void)
+{
+    uint32_t start = oled.u32BytesSent;
+
+    oledDumpBuffer(&oled, NULL);
+    display_invalidate();
+    return (int)(oled.u32BytesSent - start);
+} /* display_dump() */
+
+bool display_scroll(int page, bool on)
+{
+    if (oledScroll(&oled, page, page, 0, on) < 0) // 0 = a step every 5 frames
+        return false;
+    if (!on)
+        display_invalidate();
+    return true;
+} /* display_scroll() */
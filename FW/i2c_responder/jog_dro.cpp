@@ -0,0 +1,130 @@
+//
+// Fixed-point DRO number formatter, see jog_dro.h
+//
+#include <string.h>
+
+#include "jog_dro.h"
+
+static const uint32_t dro_pow10[DRO_DECIMALS_MAX + 1] = {1, 10, 100, 1000, 10000};
+
+// Right-align the reversed text in rev[0..len) into out
+static int dro_out_rev(char *out, const char *rev, int len, int width)
+{
+    int n = 0;
+
+    while (n < width - len)
+        out[n++] = ' ';
+    while (len)
+        out[n++] = rev[--len];
+    out[n] = 0;
+    return n;
+} /* dro_out_rev() */
+
+// Split value into the digits dro_format() prints: whole units and the
+// rounded fraction as a count of the last decimal. Returns false for the
+// values that print as a word (NaN, infinity, overflow) instead.
+static bool dro_split(float value, int decimals, uint32_t *pWhole, uint32_t *pFrac, bool *pNegative)
+{
+    uint32_t bits, mant, whole, frac;
+    uint64_t scaled, rem, half;
+    int exp, shift;
+
+    memcpy(&bits, &value, sizeof(bits));
+    *pNegative = (bits >> 31) && (bits << 1); // -0.0 prints without a sign
+    exp = (bits >> 23) & 0xff;
+    mant = bits & 0x7fffff;
+    if (exp == 0xff || value > 1e9f || value < -1e9f)
+        return false;
+
+    // value = mant * 2^-shift, whole part and scaled fraction in integers
+    if (exp)
+        mant |= 0x800000;
+    else
+        exp = 1; // denormal
+    shift = 150 - exp;
+    whole = frac = 0;
+    if (shift <= 0)
+        whole = mant << -shift;
+    else if (shift <= 40) // below 2^-16 the fraction rounds to nothing
+    {
+        whole = shift < 32 ? mant >> shift : 0;
+        scaled = (uint64_t)(mant & ((1ull << shift) - 1)) * dro_pow10[decimals];
+        frac = (uint32_t)(scaled >> shift);
+        rem = scaled & ((1ull << shift) - 1);
+        half = 1ull << (shift - 1);
+        if (rem > half || (rem == half && (frac == 0 || (frac & 1))))
+        {
+            if (++frac >= dro_pow10[decimals])
+            {
+                frac = 0;
+                whole++;
+            }
+        }
+    }
+    *pWhole = whole;
+    *pFrac = frac;
+    return true;
+} /* dro_split() */
+
+static int dro_clamp_decimals(int decimals)
+{
+    if (decimals < 1)
+        return 1;
+    if (decimals > DRO_DECIMALS_MAX)
+        return DRO_DECIMALS_MAX;
+    return decimals;
+} /* dro_clamp_decimals() */
+
+int dro_format(char *out, float value, int width, int decimals)
+{
+    char rev[DRO_TEXT_MAX];
+    uint32_t whole, frac;
+    int len = 0;
+    bool negative;
+
+    decimals = dro_clamp_decimals(decimals);
+    if (!dro_split(value, decimals, &whole, &frac, &negative))
+    {
+        if (value > 1e9f || value < -1e9f) // also infinity
+        {
+            if (value != value * 2.0f) // finite
+                return dro_out_rev(out, "fvo", 3, width);
+            return negative ? dro_out_rev(out, "fni-", 4, width) : dro_out_rev(out, "fni", 3, width);
+        }
+        return dro_out_rev(out, "nan", 3, width);
+    }
+
+    for (int i = 0; i < decimals; i++)
+    {
+        rev[len++] = '0' + frac % 10;
+        frac /= 10;
+    }
+    rev[len++] = '.';
+    do
+    {
+        rev[len++] = '0' + whole % 10;
+        whole /= 10;
+    } while (whole);
+    if (negative)
+        rev[len++] = '-';
+    return dro_out_rev(out, rev, len, width);
+} /* dro_format() */
+
+int64_t dro_quantize(float value, int decimals)
+{
+    uint32_t whole, frac;
+    int64_t count;
+    bool negative;
+
+    decimals = dro_clamp_decimals(decimals);
+    if (!dro_split(value, decimals, &whole, &frac, &negative))
+    {
+        if (value != value)
+            return DRO_KEY_NAN;
+        if (value == value * 2.0f) // infinity
+            return negative ? DRO_KEY_NINF : DRO_KEY_INF;
+        return DRO_KEY_OVF;
+    }
+    count = (int64_t)whole * dro_pow10[decimals] + frac;
+    return negative ? -count - 1 : count; // "-0.000" is not "0.000"
+} /* dro_quantize() */
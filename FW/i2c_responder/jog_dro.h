@@ -0,0 +1,44 @@
+#ifndef __JOG_DRO_H__
+#define __JOG_DRO_H__
+//
+// Fixed-point DRO number formatter
+//
+// dro_format() prints a float the way printf("%*.*f") from pico_printf
+// does, without going through double arithmetic. The value is split into
+// its mantissa and exponent once, scaled to an integer count of the last
+// shown digit (micrometres for 3 decimals, tenths of a thou for 4) and
+// rounded with the same rule as pico_printf: up above half, and at exactly
+// half up only when the last digit is odd or zero. Negative values get a
+// '-', even when they round to zero, -0.0 does not, NaN prints "nan" and
+// infinity "inf"/"-inf".
+//
+// pico_printf switches to exponent form above 1e9, dro_format() prints
+// "ovf" there instead. Nothing on the DRO gets anywhere near that.
+//
+// dro_quantize() gives the same value as an integer key of what is shown:
+// two values with the same key at the same decimals print the same text,
+// so a change test on keys ignores float noise below the last digit.
+//
+#include <stdint.h>
+
+#define DRO_DECIMALS_MAX 4
+#define DRO_TEXT_MAX 16 // "-1000000000.0000", longest text for width <= 16
+
+// dro_quantize() keys of the values that print as a word
+#define DRO_KEY_NAN  INT64_MIN
+#define DRO_KEY_INF  (INT64_MIN + 1)
+#define DRO_KEY_NINF (INT64_MIN + 2)
+#define DRO_KEY_OVF  (INT64_MIN + 3)
+
+// Write value right-aligned in width characters with decimals (1 to
+// DRO_DECIMALS_MAX) digits after the point. out needs room for
+// DRO_TEXT_MAX characters plus the terminator, more when width is larger.
+// Returns the number of characters written.
+int dro_format(char *out, float value, int width, int decimals);
+// The shown value as a count of the last decimal, negative values as
+// -count - 1 (they keep their '-' when they round to zero)
+int64_t dro_quantize(float value, int decimals);
+// The resolution of a displayed coordinate, 4 decimals in inches and 3 in mm
+static inline int dro_decimals(bool imperial) { return imperial ? 4 : 3; }
+
+#endif // __JOG_DRO_H__
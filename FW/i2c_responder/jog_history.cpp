@@ -0,0 +1,56 @@
+//
+// Status history, see jog_history.h
+//
+#include "jog_history.h"
+
+static uint32_t history_time_ms[HISTORY_SAMPLES];
+static uint16_t history_feed[HISTORY_SAMPLES];
+static uint16_t history_rpm[HISTORY_SAMPLES];
+static uint16_t *const history_series[HISTORY_SERIES] = {history_feed, history_rpm};
+static uint32_t u32Seq;
+
+// Saturating conversion, NaN and negative values are 0
+static uint16_t history_fixed(float value, int frac)
+{
+    value *= (float)(1 << frac);
+    if (!(value > 0.0f))
+        return 0;
+    if (value >= 65535.0f)
+        return 65535;
+    return (uint16_t)(value + 0.5f);
+} /* history_fixed() */
+
+void history_clear(void)
+{
+    u32Seq = 0;
+} /* history_clear() */
+
+void history_add(uint32_t time_ms, float feed_rate, int spindle_rpm)
+{
+    int i = u32Seq & (HISTORY_SAMPLES - 1);
+
+    history_time_ms[i] = time_ms;
+    history_feed[i] = history_fixed(feed_rate, HISTORY_FEED_FRAC);
+    history_rpm[i] = spindle_rpm <= 0 ? 0 : spindle_rpm > 65535 ? 65535 : spindle_rpm;
+    u32Seq++;
+} /* history_add() */
+
+uint32_t history_seq(void)
+{
+    return u32Seq;
+} /* history_seq() */
+
+int history_count(void)
+{
+    return u32Seq < HISTORY_SAMPLES ? u32Seq : HISTORY_SAMPLES;
+} /* history_count() */
+
+uint16_t history_value(int series, uint32_t seq)
+{
+    return history_series[series][seq & (HISTORY_SAMPLES - 1)];
+} /* history_value() */
+
+uint32_t history_time(uint32_t seq)
+{
+    return history_time_ms[seq & (HISTORY_SAMPLES - 1)];
+} /* history_time() */
@@ -0,0 +1,49 @@
+#ifndef __JOG_HISTORY_H__
+#define __JOG_HISTORY_H__
+//
+// Status history
+//
+// A ring of the last HISTORY_SAMPLES status samples, for the sparklines.
+// Every sample has a time stamp, the feed rate and the spindle speed. They
+// are kept as one array per field rather than one array of structs: the
+// sparkline of a series walks one dense uint16_t array, and no padding is
+// spent on mixing 32 and 16 bit fields.
+//
+// Values are unsigned fixed point, saturated at the top of the range:
+// feed in 1/2^HISTORY_FEED_FRAC units per minute (mm or inch, as reported),
+// spindle speed in whole rpm.
+//
+// RAM: HISTORY_SAMPLE_BYTES (8) per sample, 1 KB for the default 128.
+// HISTORY_SAMPLES can be set at build time, HISTORY_RAM_MAX caps it.
+//
+#include <stdint.h>
+
+#ifndef HISTORY_SAMPLES
+#define HISTORY_SAMPLES 128 // a power of 2, one per column of a full width sparkline
+#endif
+#define HISTORY_RAM_MAX 4096 // bytes the ring may take
+#define HISTORY_SAMPLE_BYTES (sizeof(uint32_t) + 2 * sizeof(uint16_t))
+#define HISTORY_FEED_FRAC 1 // fraction bits of the feed values, 0-32767.5
+
+static_assert((HISTORY_SAMPLES & (HISTORY_SAMPLES - 1)) == 0, "HISTORY_SAMPLES must be a power of 2");
+static_assert(HISTORY_SAMPLES * HISTORY_SAMPLE_BYTES <= HISTORY_RAM_MAX, "status history over its RAM ceiling");
+
+enum {
+    HISTORY_FEED = 0,
+    HISTORY_RPM,
+    HISTORY_SERIES
+};
+
+// Drop every sample
+void history_clear(void);
+// Add a sample, the oldest one makes room when the ring is full
+void history_add(uint32_t time_ms, float feed_rate, int spindle_rpm);
+// Samples added since the start, the newest one is number history_seq() - 1.
+// The last history_count() numbers can be read.
+uint32_t history_seq(void);
+int history_count(void);
+// Sample seq of a series (HISTORY_xxx) and its time stamp
+uint16_t history_value(int series, uint32_t seq);
+uint32_t history_time(uint32_t seq);
+
+#endif // __JOG_HISTORY_H__
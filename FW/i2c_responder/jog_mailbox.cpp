@@ -0,0 +1,62 @@
+//
+// Core to core mailbox, see jog_mailbox.h
+//
+#include <string.h>
+
+#include "hardware/sync.h"
+
+#include "jog_mailbox.h"
+
+void mailbox_publish(mailbox_t *mb, const void *src)
+{
+    mb->seq = mb->seq + 1; // odd, a write is going on
+    __dmb();
+    memcpy(mb->data, src, mb->size);
+    __dmb();
+    mb->seq = mb->seq + 1;
+    __sev();
+} /* mailbox_publish() */
+
+bool mailbox_fetch(mailbox_t *mb, void *dst, uint32_t *seen)
+{
+    uint32_t seq = mb->seq;
+
+    if (seq == *seen || (seq & 1)) // nothing new, or the writer is at it
+        return false;
+    for (;;) {
+        __dmb();
+        memcpy(dst, mb->data, mb->size);
+        __dmb();
+        if (mb->seq == seq)
+            break;
+        do // torn by a write, dst is no good until the next one is copied
+            seq = mb->seq;
+        while (seq & 1);
+    }
+    *seen = seq;
+    return true;
+} /* mailbox_fetch() */
+
+bool mailbox_post(mailbox_t *mb, uint32_t event)
+{
+    uint8_t next = (mb->head + 1) & (MAILBOX_EVENTS - 1);
+
+    if (next == mb->tail)
+        return false;
+    mb->events[mb->head] = event;
+    __dmb(); // the word before the index that hands it over
+    mb->head = next;
+    __sev();
+    return true;
+} /* mailbox_post() */
+
+bool mailbox_take(mailbox_t *mb, uint32_t *event)
+{
+    if (mb->tail == mb->head)
+        return false;
+    __dmb();
+    *event = mb->events[mb->tail];
+    __dmb(); // read before the slot is given back
+    mb->tail = (mb->tail + 1) & (MAILBOX_EVENTS - 1);
+    return true;
+} /* mailbox_take() */
@@ -0,0 +1,46 @@
+#ifndef __JOG_MAILBOX_H__
+#define __JOG_MAILBOX_H__
+//
+// Core to core mailbox
+//
+// One side writes, the other reads. The mailbox holds the latest snapshot
+// of some state, written whole by mailbox_publish() and copied out whole by
+// mailbox_fetch(), and a reader that falls behind simply gets the newest
+// one. A sequence count that is odd while a write is going on (a seqlock)
+// keeps a snapshot from being seen half written. The writer never waits.
+// The reader doesn't start a copy while a write is going on, it reports
+// nothing new and tries again on its next pass. Only when a write lands
+// during its copy does it wait for that write to end and copy again, so
+// the wait is one write at a time. Next to the snapshot is a short queue
+// of event words, those are all delivered, in order.
+//
+// Both ends may be on the same core too. Writes end with __sev(), so a
+// reader sleeping in __wfe() on the other core wakes up.
+//
+#include <stdint.h>
+
+#define MAILBOX_EVENTS 8 // queued event words, a power of 2
+
+typedef struct {
+    void *data;    // the snapshot
+    uint32_t size; // bytes
+    volatile uint32_t seq;
+    volatile uint8_t head, tail;
+    uint32_t events[MAILBOX_EVENTS];
+} mailbox_t;
+
+// A mailbox for the snapshot variable buffer
+#define MAILBOX_INIT(buffer) {&(buffer), sizeof(buffer), 0, 0, 0, {0}}
+
+// Replace the snapshot with size bytes from src
+void mailbox_publish(mailbox_t *mb, const void *src);
+// Copy the snapshot to dst if it is newer than the one *seen says (start
+// with 0), returns false if there was nothing new or a write is going on,
+// dst is then untouched
+bool mailbox_fetch(mailbox_t *mb, void *dst, uint32_t *seen);
+// Queue an event word, returns false if the queue is full
+bool mailbox_post(mailbox_t *mb, uint32_t event);
+// Take the oldest event word, returns false if there is none
+bool mailbox_take(mailbox_t *mb, uint32_t *event);
+
+#endif // __JOG_MAILBOX_H__
@@ -0,0 +1,109 @@
+//
+// Timed notifications, see jog_notify.h
+//
+#include <string.h>
+
+#include "hardware/timer.h"
+
+#include "jog_notify.h"
+
+typedef struct {
+    char text[NOTIFY_TEXT_MAX + 1];
+    uint8_t priority;
+    bool used;
+    uint32_t posted_us;
+    uint32_t expire_us;
+} notify_t;
+
+static notify_t notify_queue[NOTIFY_MAX];
+static int iShown = -1; // queue slot on the overlay
+static char notify_text[NOTIFY_TEXT_MAX + 1];
+static const widget_t notify_widget = {0, NOTIFY_PAGE, FONT_8x8, NOTIFY_TEXT_MAX, notify_text, NULL};
+
+// a before b on the overlay
+static bool notify_before(const notify_t *a, const notify_t *b)
+{
+    if (a->priority != b->priority)
+        return a->priority > b->priority;
+    return (int32_t)(a->posted_us - b->posted_us) > 0;
+} /* notify_before() */
+
+bool notify_post(const char *text, uint8_t priority, uint32_t duration_ms)
+{
+    notify_t *n = NULL;
+    uint32_t now = time_us_32();
+
+    for (int i = 0; i < NOTIFY_MAX && !n; i++) {
+        if (notify_queue[i].used && strncmp(notify_queue[i].text, text, NOTIFY_TEXT_MAX) == 0)
+            n = &notify_queue[i];
+    }
+    for (int i = 0; i < NOTIFY_MAX && !n; i++) {
+        if (!notify_queue[i].used)
+            n = &notify_queue[i];
+    }
+    if (!n) { // full, make room
+        n = &notify_queue[0];
+        for (int i = 1; i < NOTIFY_MAX; i++) {
+            if (notify_before(n, &notify_queue[i]))
+                n = &notify_queue[i];
+        }
+        if (n->priority > priority)
+            return false;
+    }
+    strncpy(n->text, text, NOTIFY_TEXT_MAX);
+    n->text[NOTIFY_TEXT_MAX] = 0;
+    n->priority = priority;
+    n->used = true;
+    n->posted_us = now;
+    n->expire_us = now + duration_ms * 1000;
+    iShown = -2; // look again on the next update, even if the same slot wins
+    return true;
+} /* notify_post() */
+
+void notify_clear(void)
+{
+    for (int i = 0; i < NOTIFY_MAX; i++)
+        notify_queue[i].used = false;
+    iShown = -2;
+} /* notify_clear() */
+
+bool notify_update(void)
+{
+    uint32_t now = time_us_32();
+    char text[NOTIFY_TEXT_MAX + 1];
+    int best = -1, len;
+    bool changed;
+
+    for (int i = 0; i < NOTIFY_MAX; i++) {
+        if (!notify_queue[i].used)
+            continue;
+        if ((int32_t)(now - notify_queue[i].expire_us) >= 0) {
+            notify_queue[i].used = false;
+            continue;
+        }
+        if (best < 0 || notify_before(&notify_queue[i], &notify_queue[best]))
+            best = i;
+    }
+    if (best == iShown)
+        return false;
+    iShown = best;
+    if (best < 0) {
+        changed = notify_text[0] != 0;
+        notify_text[0] = 0;
+        widget_overlay(NULL);
+        return changed;
+    }
+    // centred in the bar, the widget pads the rest
+    len = strlen(notify_queue[best].text);
+    memset(text, ' ', (NOTIFY_TEXT_MAX - len) / 2);
+    strcpy(&text[(NOTIFY_TEXT_MAX - len) / 2], notify_queue[best].text);
+    changed = strcmp(notify_text, text) != 0;
+    strcpy(notify_text, text);
+    widget_overlay(&notify_widget);
+    return changed;
+} /* notify_update() */
+
+bool notify_showing(void)
+{
+    return notify_text[0] != 0;
+} /* notify_showing() */
@@ -0,0 +1,39 @@
+#ifndef __JOG_NOTIFY_H__
+#define __JOG_NOTIFY_H__
+//
+// Timed notifications
+//
+// Short messages that show over the normal screen for a while, instead of
+// holding the firmware in a sleep while they are on. Each one has a priority
+// and an expiry time. notify_update() drops the expired ones and puts the
+// most important one left (the newest of equal priority) into the display
+// overlay, so an alarm replaces a lower message right away and the screen
+// underneath comes back once the last one has expired.
+//
+#include <stdint.h>
+#include "jog_widget.h"
+
+#define NOTIFY_MAX 4      // queued messages
+#define NOTIFY_TEXT_MAX 16 // one line of FONT_8x8
+#define NOTIFY_PAGE 1     // the page row the overlay covers
+
+enum {
+    NOTIFY_INFO = 0,
+    NOTIFY_WARN,
+    NOTIFY_ALARM
+};
+
+// Queue text for duration_ms. The same text already queued only gets the
+// new priority and expiry. With the queue full the least important (then
+// the oldest) message makes room, unless it is more important than this
+// one: returns false then, and nothing is queued.
+bool notify_post(const char *text, uint8_t priority, uint32_t duration_ms);
+// Drop every queued message
+void notify_clear(void);
+// Expire messages and update the overlay, returns true when what it shows
+// changed and the screen needs a new frame
+bool notify_update(void);
+// Whether a message is on the overlay now
+bool notify_showing(void);
+
+#endif // __JOG_NOTIFY_H__
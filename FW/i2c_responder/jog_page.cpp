@@ -0,0 +1,50 @@
+//
+// Screen pages, see jog_page.h
+//
+#include <string.h>
+
+#include "jog_page.h"
+
+static const page_t *page_cached[PAGE_CACHE_MAX]; // the page in each bitmap, NULL = free
+static uint8_t page_cache[PAGE_CACHE_MAX][DISPLAY_BUFFER_SIZE];
+
+// Copy the back buffer to a bitmap (bSave) or back, row by row: the back
+// buffer stride need not be the panel width
+static void page_copy(uint8_t *pBitmap, bool bSave)
+{
+    int width = display_width();
+    int rows = display_height() / 8;
+
+    if (rows * width > DISPLAY_BUFFER_SIZE)
+        rows = DISPLAY_BUFFER_SIZE / width; // a panel display_init() turned down
+    for (int page = 0; page < rows; page++) {
+        if (bSave)
+            memcpy(&pBitmap[page * width], display_row(page), width);
+        else
+            memcpy(display_row(page), &pBitmap[page * width], width);
+    }
+} /* page_copy() */
+
+bool page_show(const page_t *page)
+{
+    int slot = -1;
+
+    if (!widget_show(page->widgets, page->count))
+        return false;
+    for (int i = 0; i < PAGE_CACHE_MAX; i++) {
+        if (page_cached[i] == page) {
+            page_copy(page_cache[i], false);
+            return true;
+        }
+    }
+    for (int i = 0; i < PAGE_CACHE_MAX && slot < 0; i++) {
+        if (!page_cached[i])
+            slot = i; // first view, keep it here
+    }
+    (*page->chrome)();
+    if (slot >= 0) {
+        page_copy(page_cache[slot], true);
+        page_cached[slot] = page;
+    }
+    return true;
+} /* page_show() */
@@ -0,0 +1,32 @@
+#ifndef __JOG_PAGE_H__
+#define __JOG_PAGE_H__
+//
+// Screen pages
+//
+// A page is a screen of its own next to the machine state layouts: a static
+// part (title bar, labels, frames) drawn by its chrome function, and the
+// widgets for the live fields on top. The chrome is only drawn the first
+// time the page is shown. It is then kept in a bitmap of the whole screen,
+// and showing the page again copies that back into the back buffer before
+// the widgets draw their fields. A page that is not showing costs nothing,
+// its fields are never formatted.
+//
+// RAM: PAGE_CACHE_MAX bitmaps of DISPLAY_BUFFER_SIZE (1 KB) each. A page
+// past those draws its chrome every time it is shown.
+//
+#include <stdint.h>
+#include "jog_widget.h"
+
+#define PAGE_CACHE_MAX 4
+
+typedef struct {
+    void (*chrome)(void);     // draws the static part into a cleared back buffer
+    const widget_t *widgets;  // the live fields
+    uint8_t count;
+} page_t;
+
+// Make page the current layout, over its chrome. Returns true if it was
+// not showing already (the back buffer changed).
+bool page_show(const page_t *page);
+
+#endif // __JOG_PAGE_H__
@@ -0,0 +1,176 @@
+//
+// Time-triggered cooperative scheduler, see jog_sched.h
+//
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico/time.h"
+#include "hardware/sync.h"
+
+#include "jog_sched.h"
+
+static sched_task_t *pTasks;
+static int iTaskCount;
+static uint64_t u64StatsStart; // time the statistics were last cleared
+static uint64_t u64IdleTotal;  // time spent asleep in sched_idle()
+static uint32_t u32Wakeups;
+
+#define SCHED_IDLE_MIN_US 20   // not worth sleeping for less
+
+// true once the 32 bit microsecond clock has passed t, wrap safe
+static bool sched_reached(uint32_t now, uint32_t t)
+{
+    return (int32_t)(now - t) >= 0;
+}
+
+static void sched_clear_stats(void)
+{
+    for (int i = 0; i < iTaskCount; i++) {
+        pTasks[i].runs = 0;
+        pTasks[i].overruns = 0;
+        pTasks[i].late = 0;
+        pTasks[i].wcet_us = 0;
+        pTasks[i].total_us = 0;
+    }
+    u64IdleTotal = 0;
+    u32Wakeups = 0;
+    u64StatsStart = time_us_64();
+} /* sched_clear_stats() */
+
+void sched_init(sched_task_t *tasks, int count)
+{
+    sched_task_t t;
+    uint32_t now = time_us_32();
+
+    pTasks = tasks;
+    iTaskCount = count;
+    // insertion sort, the table is tiny and only sorted once
+    for (int i = 1; i < count; i++) {
+        t = tasks[i];
+        int j = i - 1;
+        while (j >= 0 && tasks[j].priority > t.priority) {
+            tasks[j + 1] = tasks[j];
+            j--;
+        }
+        tasks[j + 1] = t;
+    }
+    for (int i = 0; i < count; i++) {
+        tasks[i].release_us = now;
+        tasks[i].released = true;
+    }
+    sched_clear_stats();
+} /* sched_init() */
+
+bool sched_dispatch(void)
+{
+    uint32_t start, end, run;
+    sched_task_t *t;
+
+    start = time_us_32();
+    for (int i = 0; i < iTaskCount; i++) {
+        t = &pTasks[i];
+        if (!t->released || !sched_reached(start, t->release_us))
+            continue;
+
+        if (!t->period_us) {
+            t->released = false; // until the next trigger
+        } else if (sched_reached(start, t->release_us + t->period_us)) {
+            // missed at least one whole release, skip ahead instead of
+            // running the task back to back to catch up
+            t->late++;
+            t->release_us = start + t->period_us;
+        } else {
+            t->release_us += t->period_us; // no drift
+        }
+        (*t->fn)();
+        end = time_us_32();
+        run = end - start;
+        t->runs++;
+        t->total_us += run;
+        if (run > t->wcet_us)
+            t->wcet_us = run;
+        if (run > t->budget_us)
+            t->overruns++;
+        return true;
+    }
+    return false;
+} /* sched_dispatch() */
+
+uint32_t sched_idle_us(void)
+{
+    uint32_t now = time_us_32();
+    uint32_t idle = UINT32_MAX;
+
+    for (int i = 0; i < iTaskCount; i++) {
+        if (!pTasks[i].released)
+            continue;
+        if (sched_reached(now, pTasks[i].release_us))
+            return 0;
+        if (pTasks[i].release_us - now < idle)
+            idle = pTasks[i].release_us - now;
+    }
+    return idle;
+} /* sched_idle_us() */
+
+void sched_idle(void)
+{
+    uint32_t idle = sched_idle_us();
+    uint64_t start;
+
+    if (idle < SCHED_IDLE_MIN_US)
+        return;
+    start = time_us_64();
+    // WFE returns on the alarm, on any interrupt, or at once if an ISR did
+    // a __sev() after the due check above, so no wakeup gets lost
+    best_effort_wfe_or_timeout(make_timeout_time_us(idle));
+    u64IdleTotal += time_us_64() - start;
+    u32Wakeups++;
+} /* sched_idle() */
+
+void sched_trigger(sched_fn_t fn)
+{
+    for (int i = 0; i < iTaskCount; i++) {
+        if (pTasks[i].fn == fn) {
+            pTasks[i].release_us = time_us_32();
+            pTasks[i].released = true;
+        }
+    }
+} /* sched_trigger() */
+
+void sched_trigger_in(sched_fn_t fn, uint32_t us)
+{
+    uint32_t now = time_us_32();
+
+    for (int i = 0; i < iTaskCount; i++) {
+        if (pTasks[i].fn != fn)
+            continue;
+        if (!pTasks[i].released || (!sched_reached(now, pTasks[i].release_us) && pTasks[i].release_us - now > us)) {
+            pTasks[i].release_us = now + us;
+            pTasks[i].released = true;
+        }
+    }
+} /* sched_trigger_in() */
+
+void sched_report(bool reset)
+{
+    uint64_t elapsed = time_us_64() - u64StatsStart;
+    uint32_t permille;
+    sched_task_t *t;
+
+    if (elapsed == 0)
+        elapsed = 1;
+    printf("task      prio period_us budget_us runs     wcet_us  avg_us   cpu%%  overruns late\n");
+    for (int i = 0; i < iTaskCount; i++) {
+        t = &pTasks[i];
+        permille = (uint32_t)(t->total_us * 1000 / elapsed);
+        printf("%-9s %4u %9lu %9lu %-8lu %-8lu %-8lu %3lu.%lu %-9lu %lu\n", t->name, t->priority,
+               (unsigned long)t->period_us, (unsigned long)t->budget_us, (unsigned long)t->runs,
+               (unsigned long)t->wcet_us, (unsigned long)(t->runs ? t->total_us / t->runs : 0),
+               (unsigned long)(permille / 10), (unsigned long)(permille % 10),
+               (unsigned long)t->overruns, (unsigned long)t->late);
+    }
+    permille = (uint32_t)((elapsed - u64IdleTotal) * 1000 / elapsed);
+    printf("cpu busy %lu.%lu%%, %lu wakeups\n", (unsigned long)(permille / 10),
+           (unsigned long)(permille % 10), (unsigned long)u32Wakeups);
+    if (reset)
+        sched_clear_stats();
+} /* sched_report() */
@@ -0,0 +1,60 @@
+#ifndef __JOG_SCHED_H__
+#define __JOG_SCHED_H__
+//
+// Time-triggered cooperative scheduler
+//
+// Every task is released on a fixed period, or only by sched_trigger() and
+// sched_trigger_in() when the period is 0, and runs to completion. When
+// several tasks are due, the one with the lowest priority number goes first,
+// and after each run the scheduler starts looking from the top again, so a
+// long render never delays the link by more than one task body.
+//
+// Each run is timed against the task's budget. The scheduler keeps the worst
+// case execution time, the total time spent in the task, budget overruns and
+// releases that started more than a full period late.
+//
+// With nothing due the core sleeps in sched_idle(), the time spent there is
+// what the CPU utilization figure is computed from.
+//
+#include <stdint.h>
+
+typedef void (*sched_fn_t)(void);
+
+typedef struct {
+    const char *name;
+    sched_fn_t fn;
+    uint32_t period_us;  // 0 = only when triggered
+    uint32_t budget_us;  // longest run that is not counted as an overrun
+    uint8_t priority;    // 0 is the most urgent
+    // filled in by the scheduler
+    uint32_t release_us; // next release time
+    bool released;       // release_us stands, always true with a period
+    uint32_t runs;
+    uint32_t overruns;   // runs longer than budget_us
+    uint32_t late;       // releases started more than one period late
+    uint32_t wcet_us;    // worst case execution time
+    uint64_t total_us;   // time spent in the task since the last reset
+} sched_task_t;
+
+// Sorts the table by priority and releases every task now, those with a
+// period of 0 too
+void sched_init(sched_task_t *tasks, int count);
+// Runs the most urgent due task, returns false if nothing was due
+bool sched_dispatch(void);
+// Microseconds until the next release, 0 if something is due already
+uint32_t sched_idle_us(void);
+// Sleeps the core (WFE) until the next release or until an interrupt fires.
+// Interrupts that want a task to run early set a flag the main loop turns
+// into sched_trigger() after waking up.
+void sched_idle(void);
+// Releases the task that runs fn right away. Only from the core running the
+// dispatcher, not from an ISR: the release time is not updated atomically.
+void sched_trigger(sched_fn_t fn);
+// Releases the task that runs fn in us at the latest, an earlier release
+// stands. Same rule as sched_trigger().
+void sched_trigger_in(sched_fn_t fn, uint32_t us);
+// Prints the per task statistics and the CPU utilization to stdio, then
+// clears them if reset is set
+void sched_report(bool reset);
+
+#endif // __JOG_SCHED_H__
@@ -0,0 +1,80 @@
+//
+// Sparklines, see jog_spark.h
+//
+#include <string.h>
+
+#include "jog_display.h"
+#include "jog_history.h"
+#include "jog_spark.h"
+
+#define SPARK_SCALE_MIN 8 // a scale below one pixel per unit is no use
+
+// One column: a bar from the bottom of the page row, bit 7 is the bottom
+// pixel. Anything above 0 shows at least one pixel.
+static uint8_t spark_column(uint16_t value, uint16_t scale)
+{
+    int h = ((uint32_t)value * 8 + scale / 2) / scale;
+
+    if (h == 0 && value)
+        h = 1;
+    if (h > 8)
+        h = 8;
+    return (uint8_t)(0xff << (8 - h));
+} /* spark_column() */
+
+// The scale for the samples that end up in the box, from the current one
+static uint16_t spark_scale(const spark_t *s, uint32_t seq, int width)
+{
+    int count = history_count() < width ? history_count() : width;
+    uint16_t max = 0;
+    uint32_t want = SPARK_SCALE_MIN;
+
+    for (int i = 1; i <= count; i++) {
+        uint16_t v = history_value(s->series, seq - i);
+        if (v > max)
+            max = v;
+    }
+    while (want < max)
+        want <<= 1;
+    if (want > 32768)
+        want = 32768;
+    if (s->scale && want <= s->scale && want * 4 > s->scale)
+        return s->scale; // still fits, and not far too big
+    return (uint16_t)want;
+} /* spark_scale() */
+
+void spark_invalidate(spark_t *s)
+{
+    s->scale = 0;
+} /* spark_invalidate() */
+
+bool spark_update(spark_t *s)
+{
+    uint8_t *pCol = display_row(s->page) + s->x;
+    uint32_t seq = history_seq();
+    uint32_t fresh = seq - s->next_seq; // samples since the last update
+    int width = s->width, first;
+    uint16_t scale;
+
+    if (s->x + width > display_width())
+        width = display_width() - s->x;
+    if (width <= 0 || (s->scale && fresh == 0))
+        return false;
+    scale = spark_scale(s, seq, width);
+    if (scale != s->scale || fresh >= (uint32_t)width) {
+        first = 0; // all of it
+    } else {
+        memmove(pCol, pCol + fresh, width - fresh);
+        first = width - fresh;
+    }
+    for (int c = first; c < width; c++) {
+        // column c shows sample seq - width + c, blank before the first one kept
+        if (width - c > history_count())
+            pCol[c] = 0;
+        else
+            pCol[c] = spark_column(history_value(s->series, seq - width + c), scale);
+    }
+    s->next_seq = seq;
+    s->scale = scale;
+    return true;
+} /* spark_update() */
@@ -0,0 +1,35 @@
+#ifndef __JOG_SPARK_H__
+#define __JOG_SPARK_H__
+//
+// Sparklines
+//
+// A sparkline shows the history of one series (jog_history.h) as a bar per
+// sample, one column each, in a box one page row tall, newest on the right.
+// It is kept up incrementally: a new sample shifts the columns in the back
+// buffer one to the left and draws the one new column. The whole box is
+// only drawn again when the scale changes, when it fell too far behind and
+// after spark_invalidate().
+//
+// The scale is a power of 2 that fits the largest sample in the box. It
+// goes up as soon as a sample does not fit and down only once everything
+// fits in a quarter of it, so it does not change back and forth.
+//
+#include <stdint.h>
+
+typedef struct {
+    uint8_t x;      // left edge in pixels
+    uint8_t page;   // page row
+    uint8_t width;  // columns, at most HISTORY_SAMPLES
+    uint8_t series; // HISTORY_xxx
+    // kept by spark_update()
+    uint32_t next_seq; // history_seq() when it was last drawn
+    uint16_t scale;    // 0 = draw it all again
+} spark_t;
+
+// Draw the whole box on the next update, after its pixels were cleared
+void spark_invalidate(spark_t *s);
+// Bring the box in the back buffer up to the history, returns true if it
+// changed
+bool spark_update(spark_t *s);
+
+#endif // __JOG_SPARK_H__
@@ -0,0 +1,51 @@
+#ifndef __JOG_TASK_H__
+#define __JOG_TASK_H__
+//
+// Stackless resumable tasks (protothread style)
+//
+// A task is a plain function taking a task_t. TASK_BEGIN/TASK_END wrap its
+// body in a switch on the saved resume point, so a TASK_WAIT_UNTIL or
+// TASK_SLEEP_xx returns to the caller and the next call picks up right after
+// it. Nothing is kept on the stack between calls: state that has to survive a
+// wait must live in statics or in a struct owned by the task.
+//
+// Rules: no switch statements around a wait inside a task body, and never more
+// than one wait on the same source line.
+//
+#include "pico/time.h"
+
+typedef struct {
+    uint16_t lc;          // resume point (source line), 0 = start of the task
+    absolute_time_t wake; // deadline used by TASK_SLEEP_MS/US
+} task_t;
+
+// task function return values
+enum {
+    TASK_WAITING = 0, // suspended, call again later
+    TASK_DONE         // ran to TASK_END, starts over on the next call
+};
+
+#define TASK_INIT(t)  do { (t)->lc = 0; } while (0)
+
+#define TASK_BEGIN(t) switch ((t)->lc) { case 0:
+
+#define TASK_END(t)   } (t)->lc = 0; return TASK_DONE
+
+// Suspend until cond is true, cond is re-evaluated on every call
+#define TASK_WAIT_UNTIL(t, cond) \
+    do { (t)->lc = __LINE__; case __LINE__: if (!(cond)) return TASK_WAITING; } while (0)
+
+// Give the rest of the loop one pass
+#define TASK_YIELD(t) \
+    do { (t)->lc = __LINE__; return TASK_WAITING; case __LINE__:; } while (0)
+
+#define TASK_SLEEP_US(t, us) \
+    do { (t)->wake = make_timeout_time_us(us); TASK_WAIT_UNTIL(t, time_reached((t)->wake)); } while (0)
+
+#define TASK_SLEEP_MS(t, ms) \
+    do { (t)->wake = make_timeout_time_ms(ms); TASK_WAIT_UNTIL(t, time_reached((t)->wake)); } while (0)
+
+// True while the task is parked somewhere after TASK_BEGIN
+#define TASK_RUNNING(t) ((t)->lc != 0)
+
+#endif // __JOG_TASK_H__
@@ -0,0 +1,181 @@
+//
+// Message ticker, see jog_ticker.h
+//
+#include <string.h>
+
+#include "hardware/timer.h"
+
+#include "jog_display.h"
+#include "jog_ticker.h"
+
+enum {
+    TICKER_OFF = 0,
+    TICKER_SOFT, // moved by ticker_update()
+    TICKER_HW    // the controller scrolls it
+};
+
+static char ticker_text[TICKER_TEXT_MAX + 1]; // wanted, "" = none
+static bool bPending;                          // ticker_text not in the strip yet
+static uint8_t ucStrip[(TICKER_TEXT_MAX + TICKER_GAP) * 6];
+static int iStripLen; // columns, at least the row width
+static int iOffset;   // strip column at the left edge
+static uint8_t ticker_state = TICKER_OFF;
+static bool bDrawn;   // the window is in the back buffer
+static int iDrawnOffset; // at this strip column
+static bool bFits;    // the strip is one row wide, the controller can scroll it
+static uint32_t u32LastOther; // time_us_32() of the last frame with more than the ticker
+static bool bWipe;    // clear the row on the next draw
+static bool bCovered; // a notification is on the row
+static bool bChanged;
+static uint32_t u32NextStep;
+
+static int ticker_width(void)
+{
+    return display_width() > TICKER_ROW_MAX ? TICKER_ROW_MAX : display_width();
+} /* ticker_width() */
+
+void ticker_show(const char *text, int len)
+{
+    char t[TICKER_TEXT_MAX + 1];
+    int i;
+
+    if (len > TICKER_TEXT_MAX)
+        len = TICKER_TEXT_MAX;
+    for (i = 0; i < len && text[i]; i++)
+        t[i] = text[i] < ' ' || text[i] > '~' ? ' ' : text[i]; // the font has nothing else
+    t[i] = 0;
+    if (strcmp(t, ticker_text) == 0)
+        return;
+    strcpy(ticker_text, t);
+    bPending = true;
+} /* ticker_show() */
+
+void ticker_stop(void)
+{
+    if (!ticker_text[0])
+        return;
+    ticker_text[0] = 0;
+    bPending = true;
+} /* ticker_stop() */
+
+// Draw ticker_text into the strip, a row width of characters at a time on
+// the ticker row, which is put back afterwards
+static void ticker_render(void)
+{
+    uint8_t ucSave[TICKER_ROW_MAX], *pRow = display_row(TICKER_PAGE);
+    char chunk[TICKER_ROW_MAX / 6 + 1];
+    int width = ticker_width(), len = strlen(ticker_text), n;
+
+    memcpy(ucSave, pRow, width);
+    for (int i = 0; i < len; i += n) {
+        n = len - i < width / 6 ? len - i : width / 6;
+        memcpy(chunk, &ticker_text[i], n);
+        chunk[n] = 0;
+        display_text(0, TICKER_PAGE, chunk, FONT_6x8, false);
+        memcpy(&ucStrip[i * 6], pRow, n * 6);
+    }
+    memcpy(pRow, ucSave, width);
+    iStripLen = (len + TICKER_GAP) * 6;
+    if (iStripLen <= width) // fits, the whole row goes round
+        iStripLen = width;
+    memset(&ucStrip[len * 6], 0, iStripLen - len * 6);
+} /* ticker_render() */
+
+// Start on ticker_text, or take the old one off
+static void ticker_apply(void)
+{
+    if (ticker_state == TICKER_HW)
+        display_scroll(TICKER_PAGE, false);
+    bChanged = true;
+    bDrawn = false;
+    iOffset = 0;
+    if (!ticker_text[0]) {
+        ticker_state = TICKER_OFF;
+        bWipe = true;
+        return;
+    }
+    ticker_render();
+    bFits = iStripLen == ticker_width();
+    ticker_state = TICKER_SOFT;
+    u32NextStep = time_us_32() + TICKER_STEP_MS * 1000;
+} /* ticker_apply() */
+
+bool ticker_update(bool covered)
+{
+    uint32_t now = time_us_32();
+    bool changed;
+
+    if (bPending) {
+        bPending = false;
+        ticker_apply();
+    }
+    if (covered != bCovered) {
+        bCovered = covered;
+        if (covered && ticker_state == TICKER_HW) {
+            display_scroll(TICKER_PAGE, false);
+            ticker_state = TICKER_SOFT;
+        }
+        if (!covered) { // from the beginning again
+            iOffset = 0;
+            bDrawn = false;
+            bChanged = true;
+        }
+    }
+    if (!covered) {
+        // the window at the start is on the panel and nothing else moved for a while
+        if (ticker_state == TICKER_SOFT && bFits && bDrawn && iDrawnOffset == 0 && iOffset == 0 &&
+            now - u32LastOther >= TICKER_QUIET_MS * 1000 && display_frame_done()) {
+            if (display_scroll(TICKER_PAGE, true))
+                ticker_state = TICKER_HW;
+            else
+                bFits = false; // the panel can't, stay in software
+        }
+        if (ticker_state == TICKER_SOFT && (int32_t)(now - u32NextStep) >= 0) {
+            iOffset = (iOffset + TICKER_STEP_PX) % iStripLen;
+            u32NextStep = now + TICKER_STEP_MS * 1000;
+            bChanged = true;
+        }
+    }
+    changed = bChanged;
+    bChanged = false;
+    return changed;
+} /* ticker_update() */
+
+void ticker_flush(bool other)
+{
+    if (!other)
+        return;
+    u32LastOther = time_us_32();
+    if (ticker_state == TICKER_HW) {
+        // no RAM writes while it scrolls, stopping sends the whole frame again
+        display_scroll(TICKER_PAGE, false);
+        ticker_state = TICKER_SOFT;
+        iOffset = 0;
+        u32NextStep = u32LastOther + TICKER_STEP_MS * 1000;
+    }
+} /* ticker_flush() */
+
+void ticker_draw(void)
+{
+    uint8_t *pRow = display_row(TICKER_PAGE);
+    int width = ticker_width(), n;
+
+    if (bCovered)
+        return;
+    if (ticker_state == TICKER_OFF) {
+        if (bWipe)
+            memset(pRow, 0, width);
+        bWipe = false;
+        return;
+    }
+    // the window wraps round the end of the strip, in hardware the back
+    // buffer keeps what was sent before the scroll started
+    if (ticker_state == TICKER_HW)
+        return;
+    n = iOffset;
+    iDrawnOffset = n;
+    memcpy(pRow, &ucStrip[n], iStripLen - n < width ? iStripLen - n : width);
+    if (iStripLen - n < width)
+        memcpy(&pRow[iStripLen - n], ucStrip, width - (iStripLen - n));
+    bDrawn = true;
+} /* ticker_draw() */
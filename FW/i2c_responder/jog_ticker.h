@@ -0,0 +1,48 @@
+#ifndef __JOG_TICKER_H__
+#define __JOG_TICKER_H__
+//
+// Message ticker
+//
+// Shows the msg[] string of the status packet on one page row, moving to
+// the left in a loop. The text is drawn once, into a strip of FONT_6x8
+// columns, when the message arrives. The row is a window into the strip
+// that moves one step every TICKER_STEP_MS, a row copy and the changed
+// columns on the bus.
+//
+// On an SSD1306 that is 128 columns wide and a message that fits, the
+// controller can scroll the row by itself (display_scroll()), with no CPU
+// time or bus traffic at all. Its RAM must not be written while it does, so
+// that is only used once nothing but the ticker was sent for
+// TICKER_QUIET_MS: the hand-over happens when the window is back at the
+// start. The next frame with anything else in it stops the scroll first
+// (ticker_flush()) and the ticker goes on in software from the start.
+//
+// The row is shared with the notification overlay. While a notification
+// covers it the ticker holds still, and starts again from the beginning
+// once it is gone.
+//
+#include <stdint.h>
+
+#define TICKER_PAGE 1         // the page row it uses, NOTIFY_PAGE too
+#define TICKER_TEXT_MAX 127   // msgtype 1-127 is the length of msg[]
+#define TICKER_GAP 3          // spaces between the end of the text and the start again
+#define TICKER_ROW_MAX 128    // widest panel it can show on
+#define TICKER_STEP_MS 40     // software scroll, one step each
+#define TICKER_STEP_PX 2      // columns per step
+#define TICKER_QUIET_MS 2000  // screen unchanged this long before the controller scrolls
+
+// Show text (len characters, not terminated) from now on. The same text
+// again changes nothing.
+void ticker_show(const char *text, int len);
+// Take the message off the row, the hardware scroll stops at once
+void ticker_stop(void);
+// Move the ticker on, covered is whether a notification is on its row.
+// Call between frames only. Returns true when the row needs a new frame.
+bool ticker_update(bool covered);
+// A frame is about to be sent, other = it has more in it than the ticker.
+// Stops the hardware scroll then, before the controller RAM is written.
+void ticker_flush(bool other);
+// Put the current window into the back buffer, just before the flush
+void ticker_draw(void);
+
+#endif // __JOG_TICKER_H__
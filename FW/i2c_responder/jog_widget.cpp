@@ -0,0 +1,134 @@
+//
+// Retained-mode screen model, see jog_widget.h
+//
+#include <string.h>
+
+#include "hardware/timer.h"
+
+#include "jog_widget.h"
+
+static const widget_t *pLayout;
+static int iLayoutCount;
+static const widget_t *pOverlay;
+static char widget_cache[WIDGET_MAX + 1][WIDGET_TEXT_MAX + 1]; // text on screen, "" = unknown, the last is the overlay
+static int iNextWidget; // where widget_update_slice() goes on
+
+void widget_init(void)
+{
+    pLayout = NULL;
+    iLayoutCount = 0;
+    pOverlay = NULL;
+    widget_invalidate();
+} /* widget_init() */
+
+bool widget_show(const widget_t *layout, int count)
+{
+    if (layout == pLayout)
+        return false;
+    pLayout = layout;
+    iLayoutCount = count > WIDGET_MAX ? WIDGET_MAX : count;
+    display_fill(0);
+    widget_invalidate();
+    return true;
+} /* widget_show() */
+
+void widget_invalidate(void)
+{
+    for (int i = 0; i <= WIDGET_MAX; i++)
+        widget_cache[i][0] = 0; // padded text is never empty, so this never matches
+    iNextWidget = 0;
+} /* widget_invalidate() */
+
+// The box a widget covers, in pixels and page rows
+static void widget_box(const widget_t *w, int *x1, int *x2, int *page2)
+{
+    static const uint8_t char_w[] = {6, 8, 12, 16, 16};    // FONT_6x8 .. FONT_16x32
+    static const uint8_t char_pages[] = {1, 1, 2, 2, 4};
+
+    *x1 = w->x;
+    *x2 = w->x + w->width * char_w[w->font] - 1;
+    *page2 = w->page + char_pages[w->font] - 1;
+} /* widget_box() */
+
+static bool widget_overlaps(const widget_t *a, const widget_t *b)
+{
+    int ax1, ax2, ap2, bx1, bx2, bp2;
+
+    widget_box(a, &ax1, &ax2, &ap2);
+    widget_box(b, &bx1, &bx2, &bp2);
+    return ax1 <= bx2 && bx1 <= ax2 && a->page <= bp2 && b->page <= ap2;
+} /* widget_overlaps() */
+
+// Redraw a widget if its text changed, returns 1 if it did
+static int widget_draw(const widget_t *w, char *cache, int bInvert)
+{
+    char text[WIDGET_TEXT_MAX + 1];
+    int len;
+
+    if (w->fmt)
+        (*w->fmt)(text);
+    else
+        strncpy(text, w->text, WIDGET_TEXT_MAX);
+    text[w->width] = 0; // clip
+    len = strlen(text);
+    memset(&text[len], ' ', w->width - len); // pad
+    if (strcmp(text, cache) == 0)
+        return 0;
+    display_text(w->x, w->page, text, w->font, bInvert);
+    strcpy(cache, text);
+    return 1;
+} /* widget_draw() */
+
+// Unit i of an update pass: the layout widgets, then the overlay on top.
+// Widgets under the overlay are left alone until it goes.
+static int widget_unit(int i)
+{
+    if (i == iLayoutCount)
+        return pOverlay ? widget_draw(pOverlay, widget_cache[WIDGET_MAX], 1) : 0;
+    if (pOverlay && widget_overlaps(&pLayout[i], pOverlay))
+        return 0;
+    return widget_draw(&pLayout[i], widget_cache[i], 0);
+} /* widget_unit() */
+
+void widget_overlay(const widget_t *overlay)
+{
+    int x1, x2, page2;
+
+    if (overlay == pOverlay)
+        return;
+    if (pOverlay) // wipe its box and bring back the widgets it covered
+    {
+        widget_box(pOverlay, &x1, &x2, &page2);
+        if (x2 >= display_width())
+            x2 = display_width() - 1;
+        display_rect(x1, pOverlay->page * 8, x2, page2 * 8 + 7, false, true);
+        for (int i = 0; i < iLayoutCount; i++)
+            if (widget_overlaps(&pLayout[i], pOverlay))
+                widget_cache[i][0] = 0;
+    }
+    pOverlay = overlay;
+    widget_cache[WIDGET_MAX][0] = 0;
+} /* widget_overlay() */
+
+int widget_update(void)
+{
+    int drawn = 0;
+
+    for (int i = 0; i <= iLayoutCount; i++)
+        drawn += widget_unit(i);
+    iNextWidget = 0;
+    return drawn;
+} /* widget_update() */
+
+bool widget_update_slice(uint32_t budget_us)
+{
+    uint32_t start = time_us_32();
+
+    while (iNextWidget <= iLayoutCount) {
+        widget_unit(iNextWidget++);
+        if (time_us_32() - start >= budget_us && iNextWidget <= iLayoutCount)
+            return false;
+    }
+    iNextWidget = 0;
+    return true;
+} /* widget_update_slice() */
@@ -0,0 +1,53 @@
+#ifndef __JOG_WIDGET_H__
+#define __JOG_WIDGET_H__
+//
+// Retained-mode screen model
+//
+// A screen is a const table of widgets. Each widget owns a fixed box on the
+// display (x, page row, font and a width in characters) and shows either a
+// fixed text or whatever its format function produces from the live data.
+// The text last drawn for every widget is kept, so widget_update() only
+// touches the back buffer where the displayed text actually changed. Text
+// is padded or clipped to the widget width, so a shorter value always wipes
+// the longer one before it.
+//
+// One widget can be set as an overlay. It is drawn inverted on top of the
+// layout, the layout widgets it overlaps are held back while it shows and
+// redrawn once it is removed.
+//
+#include <stdint.h>
+#include "jog_display.h"
+
+#define WIDGET_TEXT_MAX 21 // 128 pixels of FONT_6x8
+#define WIDGET_MAX 16      // widgets in one layout
+
+// Writes the current value of the bound data as text, at most
+// WIDGET_TEXT_MAX characters plus the terminator
+typedef void (*widget_fmt_t)(char *text);
+
+typedef struct {
+    uint8_t x;        // left edge in pixels
+    uint8_t page;     // page row, 8 pixel lines each
+    uint8_t font;     // FONT_xxx, one of the fixed fonts
+    uint8_t width;    // characters (at most WIDGET_TEXT_MAX), shorter text is padded with spaces
+    const char *text; // fixed text, used when fmt is NULL
+    widget_fmt_t fmt; // data source
+} widget_t;
+
+// Start without a layout, drawing goes to the back buffer of jog_display.h
+void widget_init(void);
+// Make a layout current. Switching to a different one clears the back
+// buffer and forgets every cached value, returns true if it did.
+bool widget_show(const widget_t *layout, int count);
+// Forget the cached values, the next update redraws every widget
+void widget_invalidate(void);
+// Show overlay on top of the layout, NULL removes it
+void widget_overlay(const widget_t *overlay);
+// Redraw the widgets whose text changed, returns how many were drawn
+int widget_update(void);
+// The same in slices: redraw changed widgets until budget_us has passed,
+// going on from where the last call stopped (always at least one widget).
+// Returns true once the whole layout is up to date.
+bool widget_update_slice(uint32_t budget_us);
+
+#endif // __JOG_WIDGET_H__
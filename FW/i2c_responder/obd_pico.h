@@ -0,0 +1,107 @@
+#ifndef __OBD_PICO_H__
+#define __OBD_PICO_H__
+//
+// The part of the Arduino API that OneBitDisplay uses, on the pico-sdk
+//
+// OneBitDisplay.cpp/obd.inl are written against Arduino.h and SPI.h, this
+// maps them onto the SDK so the library builds as it is. The I2C side goes
+// through the in-tree BitBang_I2C already. SPI panels get the SPI0 block:
+// call SPI.setTX()/SPI.setSCK() with the MOSI/CLK pins before obdSPIInit(),
+// the way the Arduino-Pico core does it.
+//
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "hardware/gpio.h"
+#include "hardware/spi.h"
+
+#define PROGMEM
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define MSBFIRST 1
+#define SPI_MODE0 0
+
+static inline void pinMode(int iPin, int iMode)
+{
+    gpio_init(iPin);
+    gpio_set_dir(iPin, iMode == OUTPUT);
+    if (iMode == INPUT_PULLUP)
+        gpio_pull_up(iPin);
+}
+static inline void digitalWrite(int iPin, int iState) { gpio_put(iPin, iState); }
+static inline int digitalRead(int iPin) { return gpio_get(iPin); }
+static inline void delay(int iMs) { sleep_ms(iMs); }
+static inline void delayMicroseconds(int iUs) { sleep_us(iUs); }
+static inline unsigned long millis(void) { return to_ms_since_boot(get_absolute_time()); }
+
+// Flash is memory mapped, and BMP headers are not aligned
+static inline uint8_t pgm_read_byte(const void *p) { return *(const uint8_t *)p; }
+static inline uint16_t pgm_read_word(const void *p)
+{
+    uint16_t u16;
+    memcpy(&u16, p, sizeof(u16));
+    return u16;
+}
+#define memcpy_P memcpy
+
+struct SPISettings {
+    SPISettings(uint32_t hz, int iOrder, int iMode) : u32Hz(hz) { (void)iOrder; (void)iMode; }
+    uint32_t u32Hz;
+};
+
+class SPIClass {
+  public:
+    SPIClass(spi_inst_t *pSPI) : _pSPI(pSPI), _iTX(0xff), _iSCK(0xff) {}
+    void setTX(uint8_t iPin) { _iTX = iPin; }
+    void setSCK(uint8_t iPin) { _iSCK = iPin; }
+    void begin(void)
+    {
+        spi_init(_pSPI, 8000000);
+        if (_iTX != 0xff)
+            gpio_set_function(_iTX, GPIO_FUNC_SPI);
+        if (_iSCK != 0xff)
+            gpio_set_function(_iSCK, GPIO_FUNC_SPI);
+    }
+    void beginTransaction(SPISettings s)
+    {
+        spi_set_baudrate(_pSPI, s.u32Hz);
+        spi_set_format(_pSPI, 8, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+    }
+    void endTransaction(void) {}
+    uint8_t transfer(uint8_t c)
+    {
+        uint8_t r;
+        spi_write_read_blocking(_pSPI, &c, &r, 1);
+        return r;
+    }
+    // Like Arduino, what comes back replaces the data
+    void transfer(void *pData, size_t iLen) { spi_write_read_blocking(_pSPI, (uint8_t *)pData, (uint8_t *)pData, iLen); }
+
+  private:
+    spi_inst_t *_pSPI;
+    uint8_t _iTX, _iSCK;
+};
+inline SPIClass SPI(spi0);
+
+// Base of the ONE_BIT_DISPLAY class, text goes to its write()
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    size_t write(const uint8_t *pData, size_t iLen)
+    {
+        size_t n = 0;
+        while (iLen--)
+            n += write(*pData++);
+        return n;
+    }
+    size_t print(const char *pString) { return write((const uint8_t *)pString, strlen(pString)); }
+    size_t println(const char *pString) { return print(pString) + write('\n'); }
+};
+
+#endif // __OBD_PICO_H__
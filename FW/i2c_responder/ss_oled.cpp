@@ -24,539 +24,11 @@
 
 #include "ss_oled.h"
 
-const uint8_t ucFont[] = {
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x06,0x5f,0x5f,0x06,0x00,
-  0x00,0x07,0x07,0x00,0x07,0x07,0x00,0x14,0x7f,0x7f,0x14,0x7f,0x7f,0x14,
-  0x24,0x2e,0x2a,0x6b,0x6b,0x3a,0x12,0x46,0x66,0x30,0x18,0x0c,0x66,0x62,
-  0x30,0x7a,0x4f,0x5d,0x37,0x7a,0x48,0x00,0x04,0x07,0x03,0x00,0x00,0x00,
-  0x00,0x1c,0x3e,0x63,0x41,0x00,0x00,0x00,0x41,0x63,0x3e,0x1c,0x00,0x00,
-  0x08,0x2a,0x3e,0x1c,0x3e,0x2a,0x08,0x00,0x08,0x08,0x3e,0x3e,0x08,0x08,
-  0x00,0x00,0x80,0xe0,0x60,0x00,0x00,0x00,0x08,0x08,0x08,0x08,0x08,0x08,
-  0x00,0x00,0x00,0x60,0x60,0x00,0x00,0x60,0x30,0x18,0x0c,0x06,0x03,0x01,
-  0x3e,0x7f,0x59,0x4d,0x47,0x7f,0x3e,0x40,0x42,0x7f,0x7f,0x40,0x40,0x00,
-  0x62,0x73,0x59,0x49,0x6f,0x66,0x00,0x22,0x63,0x49,0x49,0x7f,0x36,0x00,
-  0x18,0x1c,0x16,0x53,0x7f,0x7f,0x50,0x27,0x67,0x45,0x45,0x7d,0x39,0x00,
-  0x3c,0x7e,0x4b,0x49,0x79,0x30,0x00,0x03,0x03,0x71,0x79,0x0f,0x07,0x00,
-  0x36,0x7f,0x49,0x49,0x7f,0x36,0x00,0x06,0x4f,0x49,0x69,0x3f,0x1e,0x00,
-  0x00,0x00,0x00,0x66,0x66,0x00,0x00,0x00,0x00,0x80,0xe6,0x66,0x00,0x00,
-  0x08,0x1c,0x36,0x63,0x41,0x00,0x00,0x00,0x14,0x14,0x14,0x14,0x14,0x14,
-  0x00,0x41,0x63,0x36,0x1c,0x08,0x00,0x00,0x02,0x03,0x59,0x5d,0x07,0x02,
-  0x3e,0x7f,0x41,0x5d,0x5d,0x5f,0x0e,0x7c,0x7e,0x13,0x13,0x7e,0x7c,0x00,
-  0x41,0x7f,0x7f,0x49,0x49,0x7f,0x36,0x1c,0x3e,0x63,0x41,0x41,0x63,0x22,
-  0x41,0x7f,0x7f,0x41,0x63,0x3e,0x1c,0x41,0x7f,0x7f,0x49,0x5d,0x41,0x63,
-  0x41,0x7f,0x7f,0x49,0x1d,0x01,0x03,0x1c,0x3e,0x63,0x41,0x51,0x33,0x72,
-  0x7f,0x7f,0x08,0x08,0x7f,0x7f,0x00,0x00,0x41,0x7f,0x7f,0x41,0x00,0x00,
-  0x30,0x70,0x40,0x41,0x7f,0x3f,0x01,0x41,0x7f,0x7f,0x08,0x1c,0x77,0x63,
-  0x41,0x7f,0x7f,0x41,0x40,0x60,0x70,0x7f,0x7f,0x0e,0x1c,0x0e,0x7f,0x7f,
-  0x7f,0x7f,0x06,0x0c,0x18,0x7f,0x7f,0x1c,0x3e,0x63,0x41,0x63,0x3e,0x1c,
-  0x41,0x7f,0x7f,0x49,0x09,0x0f,0x06,0x1e,0x3f,0x21,0x31,0x61,0x7f,0x5e,
-  0x41,0x7f,0x7f,0x09,0x19,0x7f,0x66,0x26,0x6f,0x4d,0x49,0x59,0x73,0x32,
-  0x03,0x41,0x7f,0x7f,0x41,0x03,0x00,0x7f,0x7f,0x40,0x40,0x7f,0x7f,0x00,
-  0x1f,0x3f,0x60,0x60,0x3f,0x1f,0x00,0x3f,0x7f,0x60,0x30,0x60,0x7f,0x3f,
-  0x63,0x77,0x1c,0x08,0x1c,0x77,0x63,0x07,0x4f,0x78,0x78,0x4f,0x07,0x00,
-  0x47,0x63,0x71,0x59,0x4d,0x67,0x73,0x00,0x7f,0x7f,0x41,0x41,0x00,0x00,
-  0x01,0x03,0x06,0x0c,0x18,0x30,0x60,0x00,0x41,0x41,0x7f,0x7f,0x00,0x00,
-  0x08,0x0c,0x06,0x03,0x06,0x0c,0x08,0x80,0x80,0x80,0x80,0x80,0x80,0x80,
-  0x00,0x00,0x03,0x07,0x04,0x00,0x00,0x20,0x74,0x54,0x54,0x3c,0x78,0x40,
-  0x41,0x7f,0x3f,0x48,0x48,0x78,0x30,0x38,0x7c,0x44,0x44,0x6c,0x28,0x00,
-  0x30,0x78,0x48,0x49,0x3f,0x7f,0x40,0x38,0x7c,0x54,0x54,0x5c,0x18,0x00,
-  0x48,0x7e,0x7f,0x49,0x03,0x06,0x00,0x98,0xbc,0xa4,0xa4,0xf8,0x7c,0x04,
-  0x41,0x7f,0x7f,0x08,0x04,0x7c,0x78,0x00,0x44,0x7d,0x7d,0x40,0x00,0x00,
-  0x60,0xe0,0x80,0x84,0xfd,0x7d,0x00,0x41,0x7f,0x7f,0x10,0x38,0x6c,0x44,
-  0x00,0x41,0x7f,0x7f,0x40,0x00,0x00,0x7c,0x7c,0x18,0x78,0x1c,0x7c,0x78,
-  0x7c,0x78,0x04,0x04,0x7c,0x78,0x00,0x38,0x7c,0x44,0x44,0x7c,0x38,0x00,
-  0x84,0xfc,0xf8,0xa4,0x24,0x3c,0x18,0x18,0x3c,0x24,0xa4,0xf8,0xfc,0x84,
-  0x44,0x7c,0x78,0x4c,0x04,0x0c,0x18,0x48,0x5c,0x54,0x74,0x64,0x24,0x00,
-  0x04,0x04,0x3e,0x7f,0x44,0x24,0x00,0x3c,0x7c,0x40,0x40,0x3c,0x7c,0x40,
-  0x1c,0x3c,0x60,0x60,0x3c,0x1c,0x00,0x3c,0x7c,0x60,0x30,0x60,0x7c,0x3c,
-  0x44,0x6c,0x38,0x10,0x38,0x6c,0x44,0x9c,0xbc,0xa0,0xa0,0xfc,0x7c,0x00,
-  0x4c,0x64,0x74,0x5c,0x4c,0x64,0x00,0x08,0x08,0x3e,0x77,0x41,0x41,0x00,
-  0x00,0x00,0x00,0x77,0x77,0x00,0x00,0x41,0x41,0x77,0x3e,0x08,0x08,0x00,
-  0x02,0x03,0x01,0x03,0x02,0x03,0x01,0x70,0x78,0x4c,0x46,0x4c,0x78,0x70};
-const uint8_t ucBigFont[] = {
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0xfc,0xfc,0xff,0xff,0xff,0xff,0xfc,0xfc,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x3f,0x3f,0x3f,0x3f,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x0f,0x0f,0x0f,0x0f,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x0f,0x0f,0x3f,0x3f,0x00,0x00,0x00,0x00,0x3f,0x3f,0x0f,0x0f,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xc0,0xc0,0xfc,0xfc,0xfc,0xfc,0xc0,0xc0,0xfc,0xfc,0xfc,0xfc,0xc0,0xc0,0x00,0x00,
-  0xc0,0xc0,0xff,0xff,0xff,0xff,0xc0,0xc0,0xff,0xff,0xff,0xff,0xc0,0xc0,0x00,0x00,
-  0x00,0x00,0x0f,0x0f,0x0f,0x0f,0x00,0x00,0x0f,0x0f,0x0f,0x0f,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0xf0,0xf0,0xf0,0xf0,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xfc,0xfc,0xff,0xff,0x03,0x03,0x03,0x03,0x03,0x03,0x0f,0x0f,0x3c,0x3c,0x00,0x00,
-  0xf0,0xf0,0xc3,0xc3,0x03,0x03,0x03,0x03,0x03,0x03,0xff,0xff,0xfc,0xfc,0x00,0x00,
-  0x00,0x00,0x03,0x03,0x03,0x03,0x3f,0x3f,0x3f,0x3f,0x03,0x03,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xf0,0xf0,0xf0,0xf0,0x00,0x00,0x00,0x00,0x00,0x00,0xc0,0xc0,0xf0,0xf0,0x00,0x00,
-  0x00,0x00,0xc0,0xc0,0xf0,0xf0,0x3c,0x3c,0x0f,0x0f,0x03,0x03,0x00,0x00,0x00,0x00,
-  0x0f,0x0f,0x03,0x03,0x00,0x00,0x00,0x00,0x00,0x00,0x0f,0x0f,0x0f,0x0f,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x3c,0x3c,0xff,0xff,0xc3,0xc3,0xff,0xff,0x3c,0x3c,0x00,0x00,0x00,0x00,
-  0xfc,0xfc,0xff,0xff,0x03,0x03,0x0f,0x0f,0xfc,0xfc,0xff,0xff,0x03,0x03,0x00,0x00,
-  0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x00,0x00,
-  0x00,0x00,0x00,0x00,0xc0,0xc0,0xc0,0xc0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x30,0x30,0x3f,0x3f,0x0f,0x0f,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0xf0,0xf0,0xfc,0xfc,0x0f,0x0f,0x03,0x03,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x03,0x03,0x0f,0x0f,0xfc,0xfc,0xf0,0xf0,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0xc0,0xc0,0xc0,0xc0,0x00,0x00,0x00,0x00,0xc0,0xc0,0xc0,0xc0,0x00,0x00,
-  0x0c,0x0c,0xcc,0xcc,0xff,0xff,0x3f,0x3f,0x3f,0x3f,0xff,0xff,0xcc,0xcc,0x0c,0x0c,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0xc0,0xc0,0xc0,0xc0,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x0c,0x0c,0x0c,0x0c,0xff,0xff,0xff,0xff,0x0c,0x0c,0x0c,0x0c,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0xc0,0xc0,0xc0,0xc0,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x30,0x30,0x3f,0x3f,0x0f,0x0f,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x0f,0x0f,0x0f,0x0f,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xc0,0xc0,0xf0,0xf0,0x00,0x00,
-  0x00,0x00,0xc0,0xc0,0xf0,0xf0,0x3c,0x3c,0x0f,0x0f,0x03,0x03,0x00,0x00,0x00,0x00,
-  0x0f,0x0f,0x03,0x03,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xfc,0xfc,0xff,0xff,0x03,0x03,0x03,0x03,0xc3,0xc3,0xff,0xff,0xfc,0xfc,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x30,0x30,0x0f,0x0f,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,
-  0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x30,0x30,0x3c,0x3c,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x03,0x03,0xc3,0xc3,0xff,0xff,0x3c,0x3c,0x00,0x00,
-  0xc0,0xc0,0xf0,0xf0,0x3c,0x3c,0x0f,0x0f,0x03,0x03,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x0f,0x0f,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x03,0x03,0x03,0x03,0xff,0xff,0xfc,0xfc,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x03,0x03,0x03,0x03,0x03,0x03,0xff,0xff,0xfc,0xfc,0x00,0x00,
-  0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0xc0,0xc0,0xf0,0xf0,0x3c,0x3c,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,
-  0x0f,0x0f,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0xff,0xff,0xff,0xff,0x0c,0x0c,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x0c,0x0c,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x00,0x00,
-  0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x0f,0x0f,0xff,0xff,0xfc,0xfc,0x00,0x00,
-  0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xf0,0xf0,0xfc,0xfc,0x0f,0x0f,0x03,0x03,0x03,0x03,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x03,0x03,0x03,0x03,0x03,0x03,0xff,0xff,0xfc,0xfc,0x00,0x00,
-  0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x0f,0x0f,0x0f,0x0f,0x03,0x03,0x03,0x03,0x03,0x03,0xff,0xff,0xff,0xff,0x00,0x00,
-  0x00,0x00,0x00,0x00,0xf0,0xf0,0xfc,0xfc,0x0f,0x0f,0x03,0x03,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x0f,0x0f,0x0f,0x0f,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xfc,0xfc,0xff,0xff,0x03,0x03,0x03,0x03,0x03,0x03,0xff,0xff,0xfc,0xfc,0x00,0x00,
-  0xfc,0xfc,0xff,0xff,0x03,0x03,0x03,0x03,0x03,0x03,0xff,0xff,0xfc,0xfc,0x00,0x00,
-  0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xfc,0xfc,0xff,0xff,0x03,0x03,0x03,0x03,0x03,0x03,0xff,0xff,0xfc,0xfc,0x00,0x00,
-  0x00,0x00,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0xff,0xff,0xff,0xff,0x00,0x00,
-  0x00,0x00,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0xf0,0xf0,0xf0,0xf0,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0xc0,0xc0,0xc0,0xc0,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x03,0x03,0x03,0x03,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0xf0,0xf0,0xf0,0xf0,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0xc0,0xc0,0xc0,0xc0,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0xc0,0xc0,0xf0,0xf0,0x3c,0x3c,0x0c,0x0c,0x00,0x00,
-  0x00,0x00,0x0c,0x0c,0x3f,0x3f,0xf3,0xf3,0xc0,0xc0,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xc3,0xc3,0xc3,0xc3,0xc3,0xc3,0xc3,0xc3,0xc3,0xc3,0xc3,0xc3,0xc3,0xc3,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x0c,0x0c,0x3c,0x3c,0xf0,0xf0,0xc0,0xc0,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0xc0,0xc0,0xf3,0xf3,0x3f,0x3f,0x0c,0x0c,0x00,0x00,
-  0x00,0x00,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x3c,0x3c,0x3f,0x3f,0x03,0x03,0x03,0x03,0xc3,0xc3,0xff,0xff,0x3c,0x3c,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x3f,0x3f,0x3f,0x3f,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x0f,0x0f,0x0f,0x0f,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xf0,0xf0,0xfc,0xfc,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0xfc,0xfc,0xf0,0xf0,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x00,0x00,0xff,0xff,0xff,0xff,0xff,0xff,0x3f,0x3f,0x00,0x00,
-  0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xc0,0xc0,0xf0,0xf0,0x3c,0x3c,0x0f,0x0f,0x3c,0x3c,0xf0,0xf0,0xc0,0xc0,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0xff,0xff,0xff,0xff,0x00,0x00,
-  0x0f,0x0f,0x0f,0x0f,0x00,0x00,0x00,0x00,0x00,0x00,0x0f,0x0f,0x0f,0x0f,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x03,0x03,0xff,0xff,0xff,0xff,0x03,0x03,0x03,0x03,0xff,0xff,0xfc,0xfc,0x00,0x00,
-  0x00,0x00,0xff,0xff,0xff,0xff,0x03,0x03,0x03,0x03,0xff,0xff,0xfc,0xfc,0x00,0x00,
-  0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xf0,0xf0,0xfc,0xfc,0x0f,0x0f,0x03,0x03,0x03,0x03,0x0f,0x0f,0x3c,0x3c,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xc0,0xc0,0x00,0x00,
-  0x00,0x00,0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x03,0x03,0xff,0xff,0xff,0xff,0x03,0x03,0x0f,0x0f,0xfc,0xfc,0xf0,0xf0,0x00,0x00,
-  0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,
-  0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x03,0x03,0xff,0xff,0xff,0xff,0x03,0x03,0xc3,0xc3,0x0f,0x0f,0x3f,0x3f,0x00,0x00,
-  0x00,0x00,0xff,0xff,0xff,0xff,0x03,0x03,0x0f,0x0f,0x00,0x00,0xc0,0xc0,0x00,0x00,
-  0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x03,0x03,0xff,0xff,0xff,0xff,0x03,0x03,0xc3,0xc3,0x0f,0x0f,0x3f,0x3f,0x00,0x00,
-  0x00,0x00,0xff,0xff,0xff,0xff,0x03,0x03,0x0f,0x0f,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x0c,0x0c,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xf0,0xf0,0xfc,0xfc,0x0f,0x0f,0x03,0x03,0x03,0x03,0x0f,0x0f,0x3c,0x3c,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x00,0x00,0x0c,0x0c,0x0c,0x0c,0xfc,0xfc,0xfc,0xfc,0x00,0x00,
-  0x00,0x00,0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x03,0x03,0x0f,0x0f,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x03,0x03,0x03,0x03,0x03,0x03,0xff,0xff,0xff,0xff,0x00,0x00,
-  0x0f,0x0f,0x0f,0x0f,0x00,0x00,0x00,0x00,0x00,0x00,0x0f,0x0f,0x0f,0x0f,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x03,0x03,0xff,0xff,0xff,0xff,0x03,0x03,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x0c,0x0c,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x03,0x03,0xff,0xff,0xff,0xff,0x03,0x03,0x00,0x00,
-  0xf0,0xf0,0xf0,0xf0,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,
-  0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x03,0x03,0xff,0xff,0xff,0xff,0x00,0x00,0xf0,0xf0,0xff,0xff,0x0f,0x0f,0x00,0x00,
-  0x00,0x00,0xff,0xff,0xff,0xff,0x0f,0x0f,0x3f,0x3f,0xf0,0xf0,0xc0,0xc0,0x00,0x00,
-  0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x00,0x00,0x00,0x00,0x0f,0x0f,0x0f,0x0f,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x03,0x03,0xff,0xff,0xff,0xff,0x03,0x03,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0x00,0x00,0xc0,0xc0,0x00,0x00,
-  0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xff,0xff,0xff,0xff,0xfc,0xfc,0xf0,0xf0,0xfc,0xfc,0xff,0xff,0xff,0xff,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x00,0x00,0x03,0x03,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,
-  0x0f,0x0f,0x0f,0x0f,0x00,0x00,0x00,0x00,0x00,0x00,0x0f,0x0f,0x0f,0x0f,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xff,0xff,0xff,0xff,0xfc,0xfc,0xf0,0xf0,0xc0,0xc0,0xff,0xff,0xff,0xff,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x00,0x00,0x03,0x03,0x0f,0x0f,0xff,0xff,0xff,0xff,0x00,0x00,
-  0x0f,0x0f,0x0f,0x0f,0x00,0x00,0x00,0x00,0x00,0x00,0x0f,0x0f,0x0f,0x0f,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xf0,0xf0,0xfc,0xfc,0x0f,0x0f,0x03,0x03,0x0f,0x0f,0xfc,0xfc,0xf0,0xf0,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,
-  0x00,0x00,0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x03,0x03,0xff,0xff,0xff,0xff,0x03,0x03,0x03,0x03,0xff,0xff,0xfc,0xfc,0x00,0x00,
-  0x00,0x00,0xff,0xff,0xff,0xff,0x03,0x03,0x03,0x03,0x03,0x03,0x00,0x00,0x00,0x00,
-  0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x0c,0x0c,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xfc,0xfc,0xff,0xff,0x03,0x03,0x03,0x03,0x03,0x03,0xff,0xff,0xfc,0xfc,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x00,0x00,0xc0,0xc0,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,
-  0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0f,0x0f,0xff,0xff,0xff,0xff,0xc3,0xc3,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x03,0x03,0xff,0xff,0xff,0xff,0x03,0x03,0x03,0x03,0xff,0xff,0xfc,0xfc,0x00,0x00,
-  0x00,0x00,0xff,0xff,0xff,0xff,0x03,0x03,0x0f,0x0f,0xff,0xff,0xf0,0xf0,0x00,0x00,
-  0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x00,0x00,0x00,0x00,0x0f,0x0f,0x0f,0x0f,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x3c,0x3c,0xff,0xff,0xc3,0xc3,0x03,0x03,0x03,0x03,0x3f,0x3f,0x3c,0x3c,0x00,0x00,
-  0xc0,0xc0,0xc0,0xc0,0x03,0x03,0x03,0x03,0x0f,0x0f,0xfc,0xfc,0xf0,0xf0,0x00,0x00,
-  0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x3f,0x3f,0x0f,0x0f,0xff,0xff,0xff,0xff,0x0f,0x0f,0x3f,0x3f,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x0c,0x0c,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,
-  0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,
-  0x3f,0x3f,0xff,0xff,0xc0,0xc0,0x00,0x00,0xc0,0xc0,0xff,0xff,0x3f,0x3f,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x03,0x03,0x0f,0x0f,0x03,0x03,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,
-  0xff,0xff,0xff,0xff,0xc0,0xc0,0xfc,0xfc,0xc0,0xc0,0xff,0xff,0xff,0xff,0x00,0x00,
-  0x00,0x00,0x0f,0x0f,0x0f,0x0f,0x00,0x00,0x0f,0x0f,0x0f,0x0f,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x0f,0x0f,0xff,0xff,0xf0,0xf0,0x00,0x00,0xf0,0xf0,0xff,0xff,0x0f,0x0f,0x00,0x00,
-  0x00,0x00,0xf0,0xf0,0xff,0xff,0x0f,0x0f,0xff,0xff,0xf0,0xf0,0x00,0x00,0x00,0x00,
-  0x0f,0x0f,0x0f,0x0f,0x00,0x00,0x00,0x00,0x00,0x00,0x0f,0x0f,0x0f,0x0f,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x03,0x03,0xff,0xff,0xff,0xff,0x03,0x03,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x0c,0x0c,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x3f,0x3f,0x0f,0x0f,0x03,0x03,0x03,0x03,0xc3,0xc3,0xff,0xff,0x3f,0x3f,0x00,0x00,
-  0xc0,0xc0,0xf0,0xf0,0x3c,0x3c,0x0f,0x0f,0x03,0x03,0x00,0x00,0xc0,0xc0,0x00,0x00,
-  0x0f,0x0f,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x03,0x03,0x03,0x03,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x0f,0x0f,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xfc,0xfc,0xf0,0xf0,0xc0,0xc0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x03,0x03,0x0f,0x0f,0x3f,0x3f,0xfc,0xfc,0xf0,0xf0,0xc0,0xc0,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x03,0x03,0x0f,0x0f,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x03,0x03,0x03,0x03,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0xc0,0xc0,0xf0,0xf0,0xc0,0xc0,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,
-  0x00,0x00,0x00,0x00,0xf0,0xf0,0xf0,0xf0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x03,0x03,0x03,0x03,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xf0,0xf0,0xfc,0xfc,0x0c,0x0c,0x0c,0x0c,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,
-  0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x03,0x03,0xff,0xff,0xff,0xff,0xc0,0xc0,0xc0,0xc0,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,0x03,0x03,0xff,0xff,0xfc,0xfc,0x00,0x00,
-  0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0x00,0x00,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0x00,0x00,0x03,0x03,0x03,0x03,0x00,0x00,
-  0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0xc0,0xc0,0xc3,0xc3,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,
-  0xfc,0xfc,0xff,0xff,0x03,0x03,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,
-  0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0x00,0x00,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x00,0x00,
-  0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0xfc,0xfc,0xff,0xff,0x03,0x03,0x0f,0x0f,0x3c,0x3c,0x00,0x00,0x00,0x00,
-  0x03,0x03,0xff,0xff,0xff,0xff,0x03,0x03,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x0c,0x0c,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0x00,0x00,0xc0,0xc0,0xc0,0xc0,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,
-  0xc3,0xc3,0xcf,0xcf,0x0c,0x0c,0x0c,0x0c,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x03,0x03,0xff,0xff,0xff,0xff,0x00,0x00,0xc0,0xc0,0xc0,0xc0,0x00,0x00,0x00,0x00,
-  0x00,0x00,0xff,0xff,0xff,0xff,0x03,0x03,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,
-  0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x00,0x00,0x00,0x00,0x0f,0x0f,0x0f,0x0f,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0xc0,0xc0,0xcf,0xcf,0xcf,0xcf,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x0c,0x0c,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xc0,0xc0,0xcf,0xcf,0xcf,0xcf,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,
-  0x00,0x00,0xf0,0xf0,0xf0,0xf0,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x00,0x00,0x00,0x00,
-  0x03,0x03,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0xc0,0xc0,0xc0,0xc0,0x00,0x00,
-  0x00,0x00,0xff,0xff,0xff,0xff,0x3c,0x3c,0xff,0xff,0xc3,0xc3,0x00,0x00,0x00,0x00,
-  0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x00,0x00,0x00,0x00,0x0f,0x0f,0x0f,0x0f,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x03,0x03,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x0c,0x0c,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0x00,0x00,0xc0,0xc0,0xc0,0xc0,0x00,0x00,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x03,0x03,0xff,0xff,0x03,0x03,0xff,0xff,0xff,0xff,0x00,0x00,
-  0x0f,0x0f,0x0f,0x0f,0x00,0x00,0x0f,0x0f,0x00,0x00,0x0f,0x0f,0x0f,0x0f,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xc0,0xc0,0xc0,0xc0,0x00,0x00,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0x00,0x00,0x00,0x00,
-  0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,
-  0x00,0x00,0x0f,0x0f,0x0f,0x0f,0x00,0x00,0x00,0x00,0x0f,0x0f,0x0f,0x0f,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0x00,0x00,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,
-  0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xc0,0xc0,0xc0,0xc0,0x00,0x00,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0x00,0x00,0x00,0x00,
-  0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,
-  0x00,0x00,0xff,0xff,0xff,0xff,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,
-  0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0x00,0x00,0xc0,0xc0,0xc0,0xc0,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,
-  0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x00,0x00,
-  0xc0,0xc0,0xc0,0xc0,0x00,0x00,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0x00,0x00,0x00,0x00,
-  0x00,0x00,0xff,0xff,0xff,0xff,0x03,0x03,0x00,0x00,0x03,0x03,0x0f,0x0f,0x00,0x00,
-  0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x0c,0x0c,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0x00,0x00,0x00,0x00,
-  0x03,0x03,0x0f,0x0f,0x3c,0x3c,0x30,0x30,0xf0,0xf0,0xc3,0xc3,0x03,0x03,0x00,0x00,
-  0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xc0,0xc0,0xc0,0xc0,0xfc,0xfc,0xff,0xff,0xc0,0xc0,0xc0,0xc0,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xc0,0xc0,0xc0,0xc0,0x00,0x00,0x00,0x00,0xc0,0xc0,0xc0,0xc0,0x00,0x00,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,
-  0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0xc0,0xc0,0xc0,0xc0,0x00,0x00,0x00,0x00,0xc0,0xc0,0xc0,0xc0,0x00,0x00,
-  0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x03,0x03,0x0f,0x0f,0x0f,0x0f,0x03,0x03,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xc0,0xc0,0xc0,0xc0,0x00,0x00,0x00,0x00,0x00,0x00,0xc0,0xc0,0xc0,0xc0,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x00,0x00,0xf0,0xf0,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,
-  0x03,0x03,0x0f,0x0f,0x0f,0x0f,0x03,0x03,0x0f,0x0f,0x0f,0x0f,0x03,0x03,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xc0,0xc0,0xc0,0xc0,0x00,0x00,0x00,0x00,0x00,0x00,0xc0,0xc0,0xc0,0xc0,0x00,0x00,
-  0x00,0x00,0x03,0x03,0xff,0xff,0xfc,0xfc,0xff,0xff,0x03,0x03,0x00,0x00,0x00,0x00,
-  0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xc0,0xc0,0xc0,0xc0,0x00,0x00,0x00,0x00,0x00,0x00,0xc0,0xc0,0xc0,0xc0,0x00,0x00,
-  0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,
-  0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0xcc,0xcc,0xff,0xff,0x3f,0x3f,0x00,0x00,
-  0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0xc0,0x00,0x00,
-  0x03,0x03,0xc3,0xc3,0xf0,0xf0,0x3c,0x3c,0x0f,0x0f,0x03,0x03,0x00,0x00,0x00,0x00,
-  0x0f,0x0f,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x0f,0x0f,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0xfc,0xfc,0xff,0xff,0x03,0x03,0x03,0x03,0x00,0x00,
-  0x00,0x00,0x03,0x03,0x03,0x03,0xff,0xff,0xfc,0xfc,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0c,0x0c,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0xfc,0xfc,0xfc,0xfc,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x0f,0x0f,0x0f,0x0f,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x03,0x03,0x03,0x03,0xff,0xff,0xfc,0xfc,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0xfc,0xfc,0xff,0xff,0x03,0x03,0x03,0x03,0x00,0x00,
-  0x00,0x00,0x0c,0x0c,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x0f,0x0f,0x0c,0x0c,0x0f,0x0f,0x03,0x03,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
-  0x00,0x00,0x00,0x00,0xc0,0xc0,0xf0,0xf0,0xc0,0xc0,0x00,0x00,0x00,0x00,0x00,0x00,
-  0xfc,0xfc,0xff,0xff,0x03,0x03,0x00,0x00,0x03,0x03,0xff,0xff,0xfc,0xfc,0x00,0x00,
-  0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x00,0x00,
-  0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00};
-
-// 5x7 font (in 6x8 cell)
-const uint8_t ucSmallFont[] = {
-0x00,0x00,0x00,0x00,0x00,
-0x00,0x06,0x5f,0x06,0x00,
-0x07,0x03,0x00,0x07,0x03,
-0x24,0x7e,0x24,0x7e,0x24,
-0x24,0x2b,0x6a,0x12,0x00,
-0x63,0x13,0x08,0x64,0x63,
-0x36,0x49,0x56,0x20,0x50,
-0x00,0x07,0x03,0x00,0x00,
-0x00,0x3e,0x41,0x00,0x00,
-0x00,0x41,0x3e,0x00,0x00,
-0x08,0x3e,0x1c,0x3e,0x08,
-0x08,0x08,0x3e,0x08,0x08,
-0x00,0xe0,0x60,0x00,0x00,
-0x08,0x08,0x08,0x08,0x08,
-0x00,0x60,0x60,0x00,0x00,
-0x20,0x10,0x08,0x04,0x02,
-0x3e,0x51,0x49,0x45,0x3e,
-0x00,0x42,0x7f,0x40,0x00,
-0x62,0x51,0x49,0x49,0x46,
-0x22,0x49,0x49,0x49,0x36,
-0x18,0x14,0x12,0x7f,0x10,
-0x2f,0x49,0x49,0x49,0x31,
-0x3c,0x4a,0x49,0x49,0x30,
-0x01,0x71,0x09,0x05,0x03,
-0x36,0x49,0x49,0x49,0x36,
-0x06,0x49,0x49,0x29,0x1e,
-0x00,0x6c,0x6c,0x00,0x00,
-0x00,0xec,0x6c,0x00,0x00,
-0x08,0x14,0x22,0x41,0x00,
-0x24,0x24,0x24,0x24,0x24,
-0x00,0x41,0x22,0x14,0x08,
-0x02,0x01,0x59,0x09,0x06,
-0x3e,0x41,0x5d,0x55,0x1e,
-0x7e,0x11,0x11,0x11,0x7e,
-0x7f,0x49,0x49,0x49,0x36,
-0x3e,0x41,0x41,0x41,0x22,
-0x7f,0x41,0x41,0x41,0x3e,
-0x7f,0x49,0x49,0x49,0x41,
-0x7f,0x09,0x09,0x09,0x01,
-0x3e,0x41,0x49,0x49,0x7a,
-0x7f,0x08,0x08,0x08,0x7f,
-0x00,0x41,0x7f,0x41,0x00,
-0x30,0x40,0x40,0x40,0x3f,
-0x7f,0x08,0x14,0x22,0x41,
-0x7f,0x40,0x40,0x40,0x40,
-0x7f,0x02,0x04,0x02,0x7f,
-0x7f,0x02,0x04,0x08,0x7f,
-0x3e,0x41,0x41,0x41,0x3e,
-0x7f,0x09,0x09,0x09,0x06,
-0x3e,0x41,0x51,0x21,0x5e,
-0x7f,0x09,0x09,0x19,0x66,
-0x26,0x49,0x49,0x49,0x32,
-0x01,0x01,0x7f,0x01,0x01,
-0x3f,0x40,0x40,0x40,0x3f,
-0x1f,0x20,0x40,0x20,0x1f,
-0x3f,0x40,0x3c,0x40,0x3f,
-0x63,0x14,0x08,0x14,0x63,
-0x07,0x08,0x70,0x08,0x07,
-0x71,0x49,0x45,0x43,0x00,
-0x00,0x7f,0x41,0x41,0x00,
-0x02,0x04,0x08,0x10,0x20,
-0x00,0x41,0x41,0x7f,0x00,
-0x04,0x02,0x01,0x02,0x04,
-0x80,0x80,0x80,0x80,0x80,
-0x00,0x03,0x07,0x00,0x00,
-0x20,0x54,0x54,0x54,0x78,
-0x7f,0x44,0x44,0x44,0x38,
-0x38,0x44,0x44,0x44,0x28,
-0x38,0x44,0x44,0x44,0x7f,
-0x38,0x54,0x54,0x54,0x08,
-0x08,0x7e,0x09,0x09,0x00,
-0x18,0xa4,0xa4,0xa4,0x7c,
-0x7f,0x04,0x04,0x78,0x00,
-0x00,0x00,0x7d,0x40,0x00,
-0x40,0x80,0x84,0x7d,0x00,
-0x7f,0x10,0x28,0x44,0x00,
-0x00,0x00,0x7f,0x40,0x00,
-0x7c,0x04,0x18,0x04,0x78,
-0x7c,0x04,0x04,0x78,0x00,
-0x38,0x44,0x44,0x44,0x38,
-0xfc,0x44,0x44,0x44,0x38,
-0x38,0x44,0x44,0x44,0xfc,
-0x44,0x78,0x44,0x04,0x08,
-0x08,0x54,0x54,0x54,0x20,
-0x04,0x3e,0x44,0x24,0x00,
-0x3c,0x40,0x20,0x7c,0x00,
-0x1c,0x20,0x40,0x20,0x1c,
-0x3c,0x60,0x30,0x60,0x3c,
-0x6c,0x10,0x10,0x6c,0x00,
-0x9c,0xa0,0x60,0x3c,0x00,
-0x64,0x54,0x54,0x4c,0x00,
-0x08,0x3e,0x41,0x41,0x00,
-0x00,0x00,0x77,0x00,0x00,
-0x00,0x41,0x41,0x3e,0x08,
-0x02,0x01,0x02,0x01,0x00,
-0x3c,0x26,0x23,0x26,0x3c};
+// ucFont, ucSmallFont, ucBigFont, ucFont12x16 and ucFont16x16 are built
+// from fonts/*.txt by tools/fontc.cpp, already in page/column order.
+// ucBigFont and ucFont16x16 are packed (jog_asset.h), their glyphs come
+// from the cache of decoded glyphs.
+#include "ss_oled_fonts.h"
 
 // Initialization sequences
 const unsigned char oled128_initbuf[] = {0x00, 0xae,0xdc,0x00,0x81,0x40,
@@ -587,6 +59,7 @@ static int iCSPin, iDCPin, iResetPin;
 //static byte bCache[MAX_CACHE] = {0x40}; // for faster character drawing
 //static byte bEnd = 1;
 static void oledWriteCommand(SSOLED *pOLED, unsigned char c);
+static void oledSelectOps(SSOLED *pOLED);
 void InvertBytes(uint8_t *pData, uint8_t bLen);
 
 // wrapper/adapter functions to make the code work on Linux
@@ -602,8 +75,16 @@ static int16_t pgm_read_word(uint8_t *ptr)
 static void _I2CWrite(SSOLED *pOLED, unsigned char *pData, int iLen)
 {
   I2CWrite(&pOLED->bbi2c, pOLED->oled_addr, pData, iLen);
+  pOLED->u32BytesSent += iLen + 1; // + address byte
 } /* _I2CWrite() */
 
+// pixel data goes out with the 0x40 data prefix added by the I2C layer, no copy
+static void _I2CWriteData(SSOLED *pOLED, unsigned char *pData, int iLen)
+{
+  I2CWriteQueued(&pOLED->bbi2c, pOLED->oled_addr, 0x40, pData, iLen, NULL, NULL);
+  pOLED->u32BytesSent += iLen + 2; // + address and data prefix
+} /* _I2CWriteData() */
+
 #ifdef FUTURE
 static void oledCachedFlush(void)
 {
@@ -713,9 +194,12 @@ unsigned char uc[4];
 int rc = OLED_NOT_FOUND;
 
   pOLED->ucScreen = NULL; // reset backbuffer; user must provide one later
+  pOLED->bFramePending = 0;
+  pOLED->bHorizontal = 0;
   pOLED->oled_type = iType;
   pOLED->oled_flip = bFlip;
   pOLED->oled_wrap = 0; // default - disable text wrap
+  oledSelectOps(pOLED); // the requested panel until the probe below says otherwise
 #ifdef _LINUX_
   pOLED->bbi2c.iBus = sda; // bus number
 #endif
@@ -825,6 +309,7 @@ int rc = OLED_NOT_FOUND;
     pOLED->oled_x = 72;
     pOLED->oled_y = 40;
   }
+  oledSelectOps(pOLED);
   return rc;
 } /* oledInit() */
 //
@@ -911,64 +396,176 @@ int oledScrollBuffer(SSOLED *pOLED, int iStartCol, int iEndCol, int iStartRow, i
     }
     return 0;
 } /* oledScrollBuffer() */
+//
+// Panel traits: where buffer column 0 and page 0 sit in the controller RAM,
+// whether it can stream in horizontal addressing mode (SSD1306, see
+// oledStreamRect()), whether it can read its RAM back (SH1106/SH1107) and
+// whether its visible columns scroll in hardware (oledScroll()). Some of the
+// small SSD1306 panels move with the flip.
+//
+struct PanelSSD1306   { enum { iCol = 0,  iPage = 0, bStream = 1, bReadBack = 0, bScroll = 1 }; }; // 128x64, 128x32
+struct PanelSSD1306S  { enum { iCol = 0,  iPage = 0, bStream = 0, bReadBack = 0, bScroll = 0 }; }; // other sizes
+struct PanelSH1106    { enum { iCol = 2,  iPage = 0, bStream = 0, bReadBack = 1, bScroll = 0 }; }; // 128 pixels centered in 132
+struct PanelSH1107    { enum { iCol = 0,  iPage = 0, bStream = 0, bReadBack = 1, bScroll = 0 }; };
+struct Panel64x32     { enum { iCol = 32, iPage = 4, bStream = 0, bReadBack = 0, bScroll = 0 }; }; // centered in VRAM
+struct Panel64x32F    { enum { iCol = 32, iPage = 0, bStream = 0, bReadBack = 0, bScroll = 0 }; };
+struct Panel96x16     { enum { iCol = 0,  iPage = 2, bStream = 0, bReadBack = 0, bScroll = 0 }; };
+struct Panel96x16F    { enum { iCol = 32, iPage = 0, bStream = 0, bReadBack = 0, bScroll = 0 }; };
+struct Panel72x40     { enum { iCol = 28, iPage = 3, bStream = 0, bReadBack = 0, bScroll = 0 }; };
+struct Panel72x40F    { enum { iCol = 28, iPage = 0, bStream = 0, bReadBack = 0, bScroll = 0 }; };
+
 //
 // Send commands to position the "cursor" (aka memory write address)
-// to the given row and column
+// to the given row and column, in buffer coordinates
 //
-static void oledSetPosition(SSOLED *pOLED, int x, int y, int bRender)
+template <class P>
+static void oledSetAddress(SSOLED *pOLED, int x, int y)
 {
 unsigned char buf[4];
 
-  pOLED->iScreenOffset = (y*128)+x;
-  if (!bRender)
-      return; // don't send the commands to the OLED if we're not rendering the graphics now
-  if (pOLED->oled_type == OLED_64x32) // visible display starts at column 32, row 4
-  {
-    x += 32; // display is centered in VRAM, so this is always true
-    if (pOLED->oled_flip == 0) // non-flipped display starts from line 4
-       y += 4;
-  }
-  else if (pOLED->oled_type == OLED_132x64) // SH1106 has 128 pixels centered in 132
-  {
-    x += 2;
-  }
-  else if (pOLED->oled_type == OLED_96x16) // visible display starts at line 2
-  { // mapping is a bit strange on the 96x16 OLED
-    if (pOLED->oled_flip)
-      x += 32;
-    else
-      y += 2;
-  }
-  else if (pOLED->oled_type == OLED_72x40) // starts at x=28,y=3
+  x += P::iCol;
+  y += P::iPage;
+  if (P::bStream && pOLED->bHorizontal) // a stream left the SSD1306 in horizontal mode
   {
-    x += 28;
-    if (!pOLED->oled_flip)
-    {
-      y += 3;
-    }
+    buf[0] = 0x00;
+    buf[1] = 0x20; // memory addressing mode
+    buf[2] = 0x02; // page
+    _I2CWrite(pOLED, buf, 3);
+    pOLED->bHorizontal = 0;
   }
   buf[0] = 0x00; // command introducer
   buf[1] = 0xb0 | y; // set page to Y
   buf[2] = x & 0xf; // lower column address
   buf[3] = 0x10 | (x >> 4); // upper column addr
   _I2CWrite(pOLED, buf, 4);
+} /* oledSetAddress() */
+
+//
+// One entry per panel, oledInit() points the SSOLED at the one it probed,
+// so nothing on the drawing path branches on oled_type
+//
+struct oledops {
+  void (*pfnSetAddress)(SSOLED *pOLED, int x, int y);
+  uint8_t bStream;
+  uint8_t bReadBack;
+  uint8_t bScroll;
+};
+#define OLED_OPS(P) {oledSetAddress<P>, P::bStream, P::bReadBack, P::bScroll}
+
+static const struct oledops oledOps[] = {
+  OLED_OPS(PanelSSD1306), OLED_OPS(PanelSSD1306S), OLED_OPS(PanelSH1106), OLED_OPS(PanelSH1107),
+  OLED_OPS(Panel64x32), OLED_OPS(Panel64x32F), OLED_OPS(Panel96x16), OLED_OPS(Panel96x16F),
+  OLED_OPS(Panel72x40), OLED_OPS(Panel72x40F)
+};
+enum { OPS_SSD1306 = 0, OPS_SSD1306S, OPS_SH1106, OPS_SH1107, OPS_64x32, OPS_64x32F, OPS_96x16, OPS_96x16F,
+  OPS_72x40, OPS_72x40F };
+
+static void oledSelectOps(SSOLED *pOLED)
+{
+int i;
+
+  switch (pOLED->oled_type)
+  {
+    case OLED_128x64:
+    case OLED_128x32:
+      i = OPS_SSD1306;
+      break;
+    case OLED_132x64:
+      i = OPS_SH1106;
+      break;
+    case OLED_128x128:
+      i = OPS_SH1107;
+      break;
+    case OLED_64x32:
+      i = pOLED->oled_flip ? OPS_64x32F : OPS_64x32;
+      break;
+    case OLED_96x16:
+      i = pOLED->oled_flip ? OPS_96x16F : OPS_96x16;
+      break;
+    case OLED_72x40:
+      i = pOLED->oled_flip ? OPS_72x40F : OPS_72x40;
+      break;
+    default:
+      i = OPS_SSD1306S;
+      break;
+  }
+  pOLED->pOps = &oledOps[i];
+} /* oledSelectOps() */
+
+//
+// SSD1306 continuous horizontal scroll of page rows iStartPage..iEndPage
+//
+int oledScroll(SSOLED *pOLED, int iStartPage, int iEndPage, int iInterval, int bOn)
+{
+unsigned char buf[9];
+
+  if (!pOLED->pOps->bScroll)
+    return -1;
+  buf[0] = 0x00;
+  buf[1] = 0x2e; // deactivate, also before a new setup
+  if (!bOn)
+  {
+    _I2CWrite(pOLED, buf, 2);
+    return 0;
+  }
+  buf[2] = 0x27; // left horizontal scroll
+  buf[3] = 0x00;
+  buf[4] = (unsigned char)iStartPage;
+  buf[5] = (unsigned char)(iInterval & 7);
+  buf[6] = (unsigned char)iEndPage;
+  buf[7] = 0x00;
+  buf[8] = 0xff;
+  _I2CWrite(pOLED, buf, 9);
+  oledWriteCommand(pOLED, 0x2f); // activate
+  return 0;
+} /* oledScroll() */
+
+static void oledSetPosition(SSOLED *pOLED, int x, int y, int bRender)
+{
+  pOLED->iScreenOffset = (y*128)+x;
+  if (bRender) // otherwise only the back buffer is being drawn
+    (*pOLED->pOps->pfnSetAddress)(pOLED, x, y);
 } /* oledSetPosition() */
 
+//
+// Streaming: the SSD1306 can wrap a column/page window in horizontal
+// addressing mode, so a whole rectangle goes out as one data transfer with
+// no position commands in between. The SH1106/SH1107 only have page mode.
+// The panel is left in horizontal mode, oledSetPosition() switches back.
+//
+static int oledCanStream(SSOLED *pOLED)
+{
+  return pOLED->pOps->bStream;
+} /* oledCanStream() */
+
+static void oledSetWindow(SSOLED *pOLED, int x, int y, int cx, int cy)
+{
+unsigned char buf[9];
+
+  buf[0] = 0x00; // command introducer
+  buf[1] = 0x20; // memory addressing mode
+  buf[2] = 0x00; // horizontal
+  buf[3] = 0x21; // column window
+  buf[4] = x;
+  buf[5] = x + cx - 1;
+  buf[6] = 0x22; // page window
+  buf[7] = y;
+  buf[8] = y + cy - 1;
+  _I2CWrite(pOLED, buf, 9);
+  pOLED->bHorizontal = 1;
+} /* oledSetWindow() */
+
 //
 // Write a block of pixel data to the OLED
 // Length can be anything from 1 to 1024 (whole display)
 //
 static void oledWriteDataBlock(SSOLED *pOLED, unsigned char *ucBuf, int iLen, int bRender)
 {
-unsigned char ucTemp[129];
-
-  ucTemp[0] = 0x40; // data command
-// Copying the data has the benefit in SPI mode of not letting
-// the original data get overwritten by the SPI.transfer() function
   if (bRender)
   {
-      memcpy(&ucTemp[1], ucBuf, iLen);
-      _I2CWrite(pOLED, ucTemp, iLen+1);
+      _I2CWriteData(pOLED, ucBuf, iLen);
+      if (pOLED->ucShadow) // the panel has it now
+         memcpy(&pOLED->ucShadow[pOLED->iScreenOffset], ucBuf, iLen);
   }
   // Keep a copy in local buffer
   if (pOLED->ucScreen)
@@ -1317,7 +914,7 @@ unsigned char uc, ucOld;
 
   if (pOLED->ucScreen)
     uc = ucOld = pOLED->ucScreen[i];
-  else if (pOLED->oled_type == OLED_132x64 || pOLED->oled_type == OLED_128x128) // SH1106/SH1107 can read data
+  else if (pOLED->pOps->bReadBack) // SH1106/SH1107 can read data
   {
     uint8_t ucTemp[3];
      ucTemp[0] = 0x80; // one command
@@ -1345,7 +942,7 @@ unsigned char uc, ucOld;
       oledWriteDataBlock(pOLED, &uc, 1, bRender);
       pOLED->ucScreen[i] = uc;
     }
-    else if (pOLED->oled_type == OLED_132x64 || pOLED->oled_type == OLED_128x128) // end the read_modify_write operation
+    else if (pOLED->pOps->bReadBack) // end the read_modify_write operation
     {
       uint8_t ucTemp[4];
       ucTemp[0] = 0xc0; // one data
@@ -1459,6 +1056,42 @@ void oledSetTextWrap(SSOLED *pOLED, int bWrap)
 // Draw a string of normal (8x8), small (6x8) or large (16x32) characters
 // At the given col+row
 //
+//
+// Text runs: oledWriteString() collects the columns of consecutive glyphs
+// and sends each page row of the run as a single data block instead of one
+// transfer per character
+//
+static uint8_t ucRun[2][128]; // top and (double height fonts) bottom page row
+static int iRunX, iRunLen;
+
+static void oledRunAdd(SSOLED *pOLED, uint8_t *pTop, uint8_t *pBottom, int iLen)
+{
+  if (iRunLen == 0)
+    iRunX = pOLED->iCursorX;
+  memcpy(&ucRun[0][iRunLen], pTop, iLen);
+  if (pBottom)
+    memcpy(&ucRun[1][iRunLen], pBottom, iLen);
+  iRunLen += iLen;
+} /* oledRunAdd() */
+
+// a one row run continues at the current position, a two row run
+// positions both page rows starting at row y
+static void oledRunFlush(SSOLED *pOLED, int y, int iRows, int bRender)
+{
+int r;
+
+  if (iRunLen == 0)
+    return;
+  if (iRows == 1)
+    oledWriteDataBlock(pOLED, ucRun[0], iRunLen, bRender);
+  else for (r=0; r<iRows; r++)
+  {
+    oledSetPosition(pOLED, iRunX, y+r, bRender);
+    oledWriteDataBlock(pOLED, ucRun[r], iRunLen, bRender);
+  }
+  iRunLen = 0;
+} /* oledRunFlush() */
+
 int oledWriteString(SSOLED *pOLED, int iScroll, int x, int y, char *szMsg, int iSize, int bInvert, int bRender)
 {
 int i, iFontOff, iLen, iFontSkip;
@@ -1494,10 +1127,11 @@ unsigned char c, *s, ucTemp[40];
              iLen = 8 - iFontSkip;
              if (pOLED->iCursorX + iLen > pOLED->oled_x) // clip right edge
                  iLen = pOLED->oled_x - pOLED->iCursorX;
-             oledWriteDataBlock(pOLED, &ucTemp[iFontSkip], iLen, bRender); // write character pattern
+             oledRunAdd(pOLED, &ucTemp[iFontSkip], NULL, iLen); // character pattern
              pOLED->iCursorX += iLen;
              if (pOLED->iCursorX >= pOLED->oled_x-7 && pOLED->oled_wrap) // word wrap enabled?
              {
+               oledRunFlush(pOLED, pOLED->iCursorY, 1, bRender);
                pOLED->iCursorX = 0; // start at the beginning of the next line
                pOLED->iCursorY++;
                oledSetPosition(pOLED, pOLED->iCursorX, pOLED->iCursorY, bRender);
@@ -1507,7 +1141,7 @@ unsigned char c, *s, ucTemp[40];
          iScroll -= 8;
          i++;
        } // while
-//     oledCachedFlush(); // write any remaining data
+       oledRunFlush(pOLED, pOLED->iCursorY, 1, bRender); // write any remaining data
        return 0;
     } // 8x8
 #ifndef __AVR__
@@ -1519,7 +1153,7 @@ unsigned char c, *s, ucTemp[40];
       {
           if (iScroll < 16) // if characters are visible
           {
-              s = (unsigned char *)&ucBigFont[(unsigned char)(szMsg[i]-32)*64];
+              s = (unsigned char *)asset_glyph(&ucBigFont, (unsigned char)szMsg[i]);
               iLen = 16 - iFontSkip;
               if (pOLED->iCursorX + iLen > pOLED->oled_x) // clip right edge
                   iLen = pOLED->oled_x - pOLED->iCursorX;
@@ -1560,173 +1194,42 @@ unsigned char c, *s, ucTemp[40];
        return 0;
     } // 16x32
 #endif // !__AVR__
-    else if (iSize == FONT_12x16) // 6x8 stretched to 12x16
+    else if (iSize == FONT_12x16 || iSize == FONT_16x16) // 6x8 / 8x8 doubled by tools/fontc.cpp
     {
+      int iCharW = (iSize == FONT_12x16) ? 12 : 16;
       i = 0;
-      iFontSkip = iScroll % 12; // number of columns to initially skip
+      iFontSkip = iScroll % iCharW; // number of columns to initially skip
       while (pOLED->iCursorX < pOLED->oled_x && pOLED->iCursorY < (pOLED->oled_y/8)-1 && szMsg[i] != 0)
       {
-// stretch the 'normal' font instead of using the big font
-          if (iScroll < 12) // if characters are visible
+          if (iScroll < iCharW) // if characters are visible
           {
-              int tx, ty;
               c = szMsg[i] - 32;
-              unsigned char uc1, uc2, ucMask, *pDest;
-              s = (unsigned char *)&ucSmallFont[(int)c*5];
-              ucTemp[0] = 0; // first column is blank
-              memcpy(&ucTemp[1], s, 6);
+              if (iSize == FONT_12x16)
+                  memcpy(ucTemp, &ucFont12x16[(int)c * iCharW * 2], iCharW * 2); // top page, then bottom
+              else
+                  memcpy(ucTemp, asset_glyph(&ucFont16x16, szMsg[i]), iCharW * 2);
               if (bInvert)
-                  InvertBytes(ucTemp, 6);
-              // Stretch the font to double width + double height
-              memset(&ucTemp[6], 0, 24); // write 24 new bytes
-              for (tx=0; tx<6; tx++)
-              {
-                  ucMask = 3;
-                  pDest = &ucTemp[6+tx*2];
-                  uc1 = uc2 = 0;
-                  c = ucTemp[tx];
-                  for (ty=0; ty<4; ty++)
-                  {
-                      if (c & (1 << ty)) // a bit is set
-                          uc1 |= ucMask;
-                      if (c & (1 << (ty + 4)))
-                          uc2 |= ucMask;
-                      ucMask <<= 2;
-                  }
-                  pDest[0] = uc1;
-                  pDest[1] = uc1; // double width
-                  pDest[12] = uc2;
-                  pDest[13] = uc2;
-              }
-              // smooth the diagonal lines
-              for (tx=0; tx<5; tx++)
-              {
-                  uint8_t c0, c1, ucMask2;
-                  c0 = ucTemp[tx];
-                  c1 = ucTemp[tx+1];
-                  pDest = &ucTemp[6+tx*2];
-                  ucMask = 1;
-                  ucMask2 = 2;
-                  for (ty=0; ty<7; ty++)
-                  {
-                      if (((c0 & ucMask) && !(c1 & ucMask) && !(c0 & ucMask2) && (c1 & ucMask2)) || (!(c0 & ucMask) && (c1 & ucMask) && (c0 & ucMask2) && !(c1 & ucMask2)))
-                      {
-                          if (ty < 3) // top half
-                          {
-                              pDest[1] |= (1 << ((ty * 2)+1));
-                              pDest[2] |= (1 << ((ty * 2)+1));
-                              pDest[1] |= (1 << ((ty+1) * 2));
-                              pDest[2] |= (1 << ((ty+1) * 2));
-                          }
-                          else if (ty == 3) // on the border
-                          {
-                              pDest[1] |= 0x80; pDest[2] |= 0x80;
-                              pDest[13] |= 1; pDest[14] |= 1;
-                          }
-                          else // bottom half
-                          {
-                              pDest[13] |= (1 << (2*(ty-4)+1));
-                              pDest[14] |= (1 << (2*(ty-4)+1));
-                              pDest[13] |= (1 << ((ty-3) * 2));
-                              pDest[14] |= (1 << ((ty-3) * 2));
-                          }
-                      }
-                      else if (!(c0 & ucMask) && (c1 & ucMask) && (c0 & ucMask2) && !(c1 & ucMask2))
-                      {
-                          if (ty < 4) // top half
-                          {
-                              pDest[1] |= (1 << ((ty * 2)+1));
-                              pDest[2] |= (1 << ((ty+1) * 2));
-                          }
-                          else
-                          {
-                              pDest[13] |= (1 << (2*(ty-4)+1));
-                              pDest[14] |= (1 << ((ty-3) * 2));
-                          }
-                      }
-                      ucMask <<= 1; ucMask2 <<= 1;
-                  }
-              }
-              iLen = 12 - iFontSkip;
+                  InvertBytes(ucTemp, iCharW * 2);
+              iLen = iCharW - iFontSkip;
               if (pOLED->iCursorX + iLen > pOLED->oled_x) // clip right edge
                   iLen = pOLED->oled_x - pOLED->iCursorX;
-              oledSetPosition(pOLED, pOLED->iCursorX, pOLED->iCursorY, bRender);
-              oledWriteDataBlock(pOLED, &ucTemp[6+iFontSkip], iLen, bRender);
-              oledSetPosition(pOLED, pOLED->iCursorX, pOLED->iCursorY+1, bRender);
-              oledWriteDataBlock(pOLED, &ucTemp[18+iFontSkip], iLen, bRender);
+              oledRunAdd(pOLED, &ucTemp[iFontSkip], &ucTemp[iCharW+iFontSkip], iLen);
               pOLED->iCursorX += iLen;
-              if (pOLED->iCursorX >= pOLED->oled_x-11 && pOLED->oled_wrap) // word wrap enabled?
+              if (pOLED->iCursorX >= pOLED->oled_x-(iCharW-1) && pOLED->oled_wrap) // word wrap enabled?
               {
+                  oledRunFlush(pOLED, pOLED->iCursorY, 2, bRender);
                   pOLED->iCursorX = 0; // start at the beginning of the next line
                   pOLED->iCursorY += 2;
-                oledSetPosition(pOLED, pOLED->iCursorX, pOLED->iCursorY, bRender);
+                  oledSetPosition(pOLED, pOLED->iCursorX, pOLED->iCursorY, bRender);
               }
               iFontSkip = 0;
           } // if characters are visible
-          iScroll -= 12;
+          iScroll -= iCharW;
           i++;
       } // while
+      oledRunFlush(pOLED, pOLED->iCursorY, 2, bRender);
       return 0;
-    } // 12x16
-    else if (iSize == FONT_16x16) // 8x8 stretched to 16x16
-    {
-      i = 0;
-      iFontSkip = iScroll & 15; // number of columns to initially skip
-      while (pOLED->iCursorX < pOLED->oled_x && pOLED->iCursorY < (pOLED->oled_y/8)-1 && szMsg[i] != 0)
-      {   
-// stretch the 'normal' font instead of using the big font
-          if (iScroll < 16) // if characters are visible
-          {
-              int tx, ty;
-              c = szMsg[i] - 32;
-              unsigned char uc1, uc2, ucMask, *pDest;
-              s = (unsigned char *)&ucFont[(int)c*7];
-              ucTemp[0] = 0;
-              memcpy(&ucTemp[1], s, 7);
-              if (bInvert)
-                  InvertBytes(ucTemp, 8);
-              // Stretch the font to double width + double height
-              memset(&ucTemp[8], 0, 32); // write 32 new bytes
-              for (tx=0; tx<8; tx++)
-              {
-                  ucMask = 3;
-                  pDest = &ucTemp[8+tx*2];
-                  uc1 = uc2 = 0;
-                  c = ucTemp[tx];
-                  for (ty=0; ty<4; ty++)
-                  {
-                      if (c & (1 << ty)) // a bit is set
-                          uc1 |= ucMask;
-                      if (c & (1 << (ty + 4)))
-                          uc2 |= ucMask;
-                      ucMask <<= 2;
-                  }
-                  pDest[0] = uc1;
-                  pDest[1] = uc1; // double width
-                  pDest[16] = uc2;
-                  pDest[17] = uc2;
-              }
-              iLen = 16 - iFontSkip;
-              if (pOLED->iCursorX + iLen > pOLED->oled_x) // clip right edge
-                  iLen = pOLED->oled_x - pOLED->iCursorX;
-              oledSetPosition(pOLED, pOLED->iCursorX, pOLED->iCursorY, bRender);
-              oledWriteDataBlock(pOLED, &ucTemp[8+iFontSkip], iLen, bRender);
-              oledSetPosition(pOLED, pOLED->iCursorX, pOLED->iCursorY+1, bRender);
-              oledWriteDataBlock(pOLED, &ucTemp[24+iFontSkip], iLen, bRender);
-              pOLED->iCursorX += iLen;
-              if (pOLED->iCursorX >= pOLED->oled_x-15 && pOLED->oled_wrap) // word wrap enabled?
-              {
-                pOLED->iCursorX = 0; // start at the beginning of the next line
-                pOLED->iCursorY += 2;
-                oledSetPosition(pOLED, pOLED->iCursorX, pOLED->iCursorY, bRender);
-              }
-              iFontSkip = 0;
-          } // if characters are visible
-          iScroll -= 16;
-          i++;
-      } // while
-      return 0;
-    } // 16x16
+    } // 12x16, 16x16
     else if (iSize == FONT_6x8) // 6x8 font
     {
        i = 0;
@@ -1743,12 +1246,12 @@ unsigned char c, *s, ucTemp[40];
                iLen = 6 - iFontSkip;
                if (pOLED->iCursorX + iLen > pOLED->oled_x) // clip right edge
                    iLen = pOLED->oled_x - pOLED->iCursorX;
-               oledWriteDataBlock(pOLED, &ucTemp[iFontSkip], iLen, bRender); // write character pattern
-    //         oledCachedWrite(ucTemp, 6);
+               oledRunAdd(pOLED, &ucTemp[iFontSkip], NULL, iLen); // character pattern
                pOLED->iCursorX += iLen;
                iFontSkip = 0;
                if (pOLED->iCursorX >= pOLED->oled_x-5 && pOLED->oled_wrap) // word wrap enabled?
                {
+                 oledRunFlush(pOLED, pOLED->iCursorY, 1, bRender);
                  pOLED->iCursorX = 0; // start at the beginning of the next line
                  pOLED->iCursorY++;
                  oledSetPosition(pOLED, pOLED->iCursorX, pOLED->iCursorY, bRender);
@@ -1757,7 +1260,7 @@ unsigned char c, *s, ucTemp[40];
          iScroll -= 6;
          i++;
        }
-//    oledCachedFlush(); // write any remaining data      
+      oledRunFlush(pOLED, pOLED->iCursorY, 1, bRender); // write any remaining data
       return 0;
     } // 6x8
   return -1; // invalid size
@@ -1790,6 +1293,44 @@ int oledDrawGFX(SSOLED *pOLED, uint8_t *pBuffer, int iSrcCol, int iSrcRow, int i
 // Dump a screen's worth of data directly to the display
 // Try to speed it up by comparing the new bytes with the existing buffer
 //
+int oledStreamRect(SSOLED *pOLED, uint8_t *pBuffer, int x, int y, int cx, int cy)
+{
+int r;
+uint8_t *pSrc;
+
+  if (pBuffer == NULL)
+    pBuffer = pOLED->ucScreen;
+  if (pBuffer == NULL || x < 0 || y < 0 || cx <= 0 || cy <= 0 || x + cx > pOLED->oled_x || y + cy > (pOLED->oled_y >> 3))
+    return -1;
+  if (!oledCanStream(pOLED)) // page mode, one position command per page
+  {
+    for (r=y; r<y+cy; r++)
+    {
+      oledSetPosition(pOLED, x, r, 1);
+      oledWriteDataBlock(pOLED, &pBuffer[r*128 + x], cx, 1);
+    }
+    return 0;
+  }
+  oledSetWindow(pOLED, x, y, cx, cy);
+  if (cx == 128) // the rows are contiguous, a single transfer
+    _I2CWriteData(pOLED, &pBuffer[y*128], cx * cy);
+  else // one transfer per page, the window wraps to the next one
+  {
+    for (r=y; r<y+cy; r++)
+      _I2CWriteData(pOLED, &pBuffer[r*128 + x], cx);
+  }
+  for (r=y; r<y+cy; r++) // back buffer and shadow follow the panel
+  {
+    pSrc = &pBuffer[r*128 + x];
+    if (pOLED->ucScreen && pBuffer != pOLED->ucScreen)
+      memcpy(&pOLED->ucScreen[r*128 + x], pSrc, cx);
+    if (pOLED->ucShadow)
+      memcpy(&pOLED->ucShadow[r*128 + x], pSrc, cx);
+  }
+  pOLED->iScreenOffset = ((y+cy-1)*128 + x + cx) & 1023;
+  return 0;
+} /* oledStreamRect() */
+
 void oledDumpBuffer(SSOLED *pOLED, uint8_t *pBuffer)
 {
 int x, y;
@@ -1801,6 +1342,11 @@ uint8_t *pSrc = pOLED->ucScreen;
     pBuffer = pOLED->ucScreen;
   if (pBuffer == NULL)
     return; // no backbuffer and no provided buffer
+  if (pBuffer == pSrc && oledCanStream(pOLED)) // all of it anyway, in one go
+  {
+    oledStreamRect(pOLED, pBuffer, 0, 0, pOLED->oled_x, pOLED->oled_y >> 3);
+    return;
+  }
   
   iLines = pOLED->oled_y >> 3;
   iCols = pOLED->oled_x >> 4;
@@ -1843,6 +1389,13 @@ unsigned char temp[16];
   iCols = pOLED->oled_x >> 4;
   memset(temp, ucData, 16);
   pOLED->iCursorX = pOLED->iCursorY = 0;
+  if (bRender && pOLED->ucScreen && oledCanStream(pOLED)) // clear the back buffer and stream it
+  {
+    memset(pOLED->ucScreen, ucData, (pOLED->oled_x * pOLED->oled_y)/8);
+    oledStreamRect(pOLED, NULL, 0, 0, pOLED->oled_x, iLines);
+    pOLED->iScreenOffset = 0;
+    return;
+  }
  
   for (y=0; y<iLines; y++)
   {
@@ -1852,11 +1405,13 @@ unsigned char temp[16];
       oledWriteDataBlock(pOLED, temp, 16, bRender);
     } // for x
     // 72 isn't evenly divisible by 16, so fix it
-    if (pOLED->oled_type == OLED_72x40)
-       oledWriteDataBlock(pOLED, temp, 8, bRender);
+    if (pOLED->oled_x & 15)
+       oledWriteDataBlock(pOLED, temp, pOLED->oled_x & 15, bRender);
   } // for y
   if (pOLED->ucScreen)
     memset(pOLED->ucScreen, ucData, (pOLED->oled_x * pOLED->oled_y)/8);
+  if (pOLED->ucShadow && bRender)
+    memset(pOLED->ucShadow, ucData, (pOLED->oled_x * pOLED->oled_y)/8);
 } /* oledFill() */
 
 //
@@ -1871,6 +1426,136 @@ void oledSetBackBuffer(SSOLED *pOLED, uint8_t *pBuffer)
   pOLED->ucScreen = pBuffer;
 } /* oledSetBackBuffer() */
 
+void oledSetShadowBuffer(SSOLED *pOLED, uint8_t *pShadow)
+{
+  pOLED->ucShadow = pShadow;
+  pOLED->bShadowValid = 0; // contents unknown until the first full flush
+} /* oledSetShadowBuffer() */
+//
+// A new run costs a position command (4 bytes + address) plus the data
+// prefix and address of the next write, so gaps shorter than this are
+// cheaper to resend than to skip
+//
+#define FLUSH_MIN_GAP 8
+// window command (9 bytes + address) and the whole frame as one transfer
+#define FLUSH_STREAM_COST(p) (10 + ((p)->oled_x * (p)->oled_y)/8 + 2)
+
+// frame fence callback, a NACK means the shadow no longer matches the panel
+static void oledFrameSent(void *pUser, int bOK)
+{
+SSOLED *pOLED = (SSOLED *)pUser;
+
+  if (!bOK)
+    pOLED->bShadowValid = 0;
+  pOLED->bFramePending = 0;
+} /* oledFrameSent() */
+
+//
+// Walk the runs of changed columns on page y, sending them if bSend
+// returns what they cost on the wire
+//
+static int oledFlushPage(SSOLED *pOLED, int y, int bSend)
+{
+int x, x0, x1, iGap, iLen, iOff, iCost = 0;
+uint8_t *pSrc, *pShadow;
+
+  pSrc = &pOLED->ucScreen[y*128];
+  pShadow = &pOLED->ucShadow[y*128];
+  x = 0;
+  while (x < pOLED->oled_x)
+  {
+    // find the start of a changed run
+    while (x < pOLED->oled_x && pOLED->bShadowValid && pSrc[x] == pShadow[x])
+      x++;
+    if (x >= pOLED->oled_x)
+      break;
+    // extend it until FLUSH_MIN_GAP unchanged bytes in a row
+    x0 = x;
+    x1 = x + 1;
+    iGap = 0;
+    for (x = x1; x < pOLED->oled_x && iGap < FLUSH_MIN_GAP; x++)
+    {
+      if (!pOLED->bShadowValid || pSrc[x] != pShadow[x])
+      {
+        x1 = x + 1;
+        iGap = 0;
+      }
+      else
+        iGap++;
+    }
+    x = x1;
+    iCost += 5 + (x1 - x0) + 2 * ((x1 - x0 + 127) / 128); // position + data transfers
+    if (!bSend)
+      continue;
+    oledSetPosition(pOLED, x0, y, 1);
+    for (iOff = x0; iOff < x1; iOff += iLen)
+    {
+      iLen = x1 - iOff;
+      if (iLen > 128) iLen = 128;
+      _I2CWriteData(pOLED, &pSrc[iOff], iLen);
+    }
+    memcpy(&pShadow[x0], &pSrc[x0], x1 - x0);
+  } // while x
+  return iCost;
+} /* oledFlushPage() */
+
+int oledFlush(SSOLED *pOLED)
+{
+int y, iLines, iCost;
+uint32_t u32Start = pOLED->u32BytesSent;
+
+  if (pOLED->ucScreen == NULL)
+    return 0;
+  if (pOLED->ucShadow == NULL) // nothing to compare against, send it all
+  {
+    oledDumpBuffer(pOLED, NULL);
+    return (int)(pOLED->u32BytesSent - u32Start);
+  }
+  iLines = pOLED->oled_y >> 3;
+  iCost = 0;
+  if (oledCanStream(pOLED)) // a mostly new frame is cheaper as one stream
+  {
+    for (y=0; y<iLines; y++)
+      iCost += oledFlushPage(pOLED, y, 0);
+  }
+  if (iCost > FLUSH_STREAM_COST(pOLED))
+    oledStreamRect(pOLED, NULL, 0, 0, pOLED->oled_x, iLines);
+  else
+  {
+    for (y=0; y<iLines; y++)
+      oledFlushPage(pOLED, y, 1);
+  }
+  pOLED->bShadowValid = 1;
+  if (pOLED->u32BytesSent != u32Start)
+  {
+    pOLED->bFramePending = 1; // before the fence, it can fire right away
+    I2CFence(&pOLED->bbi2c, oledFrameSent, pOLED);
+  }
+  return (int)(pOLED->u32BytesSent - u32Start);
+} /* oledFlush() */
+
+int oledFlushRow(SSOLED *pOLED, int y)
+{
+uint32_t u32Start = pOLED->u32BytesSent;
+
+  if (pOLED->ucScreen == NULL || pOLED->ucShadow == NULL || !pOLED->bShadowValid)
+    return -1;
+  if (y < 0 || y >= (pOLED->oled_y >> 3))
+    return 0;
+  oledFlushPage(pOLED, y, 1);
+  if (pOLED->u32BytesSent != u32Start)
+  {
+    pOLED->bFramePending = 1;
+    I2CFence(&pOLED->bbi2c, oledFrameSent, pOLED);
+  }
+  return (int)(pOLED->u32BytesSent - u32Start);
+} /* oledFlushRow() */
+
+int oledFrameDone(SSOLED *pOLED)
+{
+  return !pOLED->bFramePending;
+} /* oledFrameDone() */
+
 void oledDrawLine(SSOLED *pOLED, int x1, int y1, int x2, int y2, int bRender)
 {
   int temp;
@@ -3,6 +3,8 @@
 
 #include "BitBang_I2C.h"
 
+struct oledops; // panel specific code, picked by oledInit()
+
 typedef struct ssoleds
 {
 uint8_t oled_addr; // requested address or 0xff for automatic detection
@@ -11,6 +13,12 @@ uint8_t *ucScreen;
 uint8_t iCursorX, iCursorY;
 uint8_t oled_x, oled_y;
 int iScreenOffset;
+uint8_t *ucShadow; // what the panel shows, used by oledFlush()
+int bShadowValid;
+volatile int bFramePending; // the last oledFlush() is still being sent
+uint8_t bHorizontal; // SSD1306 left in horizontal addressing by a stream
+const struct oledops *pOps;
+uint32_t u32BytesSent; // bytes put on the wire, including the address byte
 BBI2C bbi2c;
 } SSOLED;
 // Make the Linux library interface C instead of C++
@@ -21,7 +29,11 @@ extern "C" {
 // These are defined the same in my SPI_LCD library
 #ifndef SPI_LCD_H
 
-// 4 possible font sizes: 8x8, 16x32, 6x8, 16x16 (stretched from 8x8)
+// 5 font sizes: 6x8, 8x8, 12x16 (DRO numbers), 16x16 (8x8 doubled), 16x32
+// FONT_12x16 is for numbers only: digits, sign and point have their own DRO
+// glyphs, every other character is 6x8 doubled and looks out of place next
+// to them. Large text goes in FONT_16x16.
+// The doubled ones are built from fonts/*.txt by tools/fontc.cpp, see CMakeLists.txt
 enum {
    FONT_6x8 = 0,
    FONT_8x8,
@@ -87,6 +99,42 @@ void oledSPIInit(int iType, int iDC, int iCS, int iReset, int bFlip, int bInvert
 //
 void oledSetBackBuffer(SSOLED *pOLED, uint8_t *pBuffer);
 //
+// Provide a second buffer (same size as the back buffer) that tracks what the
+// panel currently shows. With one in place you can draw with bRender=0 and
+// call oledFlush() to send only the bytes that changed.
+// Pass NULL to revoke it.
+//
+void oledSetShadowBuffer(SSOLED *pOLED, uint8_t *pShadow);
+//
+// Send the parts of the back buffer that differ from the shadow buffer,
+// one run of changed columns per page, and update the shadow.
+// Sends everything if the shadow buffer has not been synced yet.
+// Returns the number of bytes put on the wire
+// With a DMA bus backend the data is only queued (copied), so the next frame
+// can be drawn at once; oledFrameDone() tells when this one is out.
+//
+int oledFlush(SSOLED *pOLED);
+//
+// oledFlush() for page row y only (always in page mode), so a caller on a
+// blocking bus can spread one frame over several passes.
+// Needs a synced shadow buffer, returns -1 without one (use oledFlush()).
+//
+int oledFlushRow(SSOLED *pOLED, int y);
+//
+// Returns 1 once everything sent by the last oledFlush() has gone to the
+// I2C controller, flushing only then keeps frames from piling up in the queue
+//
+int oledFrameDone(SSOLED *pOLED);
+//
+// Start (bOn) or stop the SSD1306 continuous horizontal scroll of page rows
+// iStartPage to iEndPage: the controller moves their visible columns one to
+// the left every iInterval frames (0-7, the datasheet step codes) with no
+// bus traffic. Those rows must not be written while it runs, and once it
+// stops they need to be sent again.
+// returns -1 on controllers that can't (SH1106/SH1107, small panels)
+//
+int oledScroll(SSOLED *pOLED, int iStartPage, int iEndPage, int iInterval, int bOn);
+//
 // Sets the brightness (0=off, 255=brightest)
 //
 void oledSetContrast(SSOLED *pOLED, unsigned char ucContrast);
@@ -147,6 +195,15 @@ int oledSetPixel(SSOLED *pOLED, int x, int y, unsigned char ucColor, int bRender
 //
 void oledDumpBuffer(SSOLED *pOLED, uint8_t *pBuffer);
 //
+// Send a rectangle of pBuffer (NULL = the back buffer, 128 byte stride) to
+// the panel, x/cx in columns and y/cy in pages. SSD1306 panels get one
+// windowed transfer in horizontal addressing mode (one per page if the
+// rectangle is narrower than the buffer), the others fall back to page mode.
+// Back buffer and shadow buffer are updated to match.
+// returns 0 for success, -1 for invalid parameter
+//
+int oledStreamRect(SSOLED *pOLED, uint8_t *pBuffer, int x, int y, int cx, int cy);
+//
 // Render a window of pixels from a provided buffer or the library's internal buffer
 // to the display. The row values refer to byte rows, not pixel rows due to the memory
 // layout of OLEDs. Pass a src pointer of NULL to use the internal backing buffer
@@ -0,0 +1,471 @@
+//
+// fontc - build time font and bitmap compiler
+//
+// usage: fontc <output.h> <font.txt>...
+//
+// Reads bitmap fonts and images drawn as text and writes them out as
+// constexpr arrays already in SSD1306 order: for every glyph, one byte per
+// column of each 8 pixel page row, page rows top to bottom, bit 0 at the
+// top. Drawing a glyph is then a straight copy into the display buffer.
+//
+// Font file format, '#' starts a comment line outside of glyphs:
+//
+//   font <array name> <width>x<height> <first code> <last code> [packed]
+//   stretch <earlier font> [smooth]
+//   : <code> [comment]
+//   <height rows of width characters, '#' = pixel on, '.' = off>
+//   : <code>
+//   ...
+//   bitmap <name> <width>x<height>
+//   <height rows of width characters>
+//
+// A packed font and every bitmap are written in the opcode stream of
+// jog_asset.h instead, as an asset_font_t / asset_bitmap_t: the glyph or
+// image bytes in the same order, runs of blank and repeated bytes coded in
+// one or two bytes. Packed glyphs are unpacked when drawn, so only the
+// large fonts that are hardly used are worth it. A glyph or image the
+// opcodes would not make smaller is stored raw instead, and every stream is
+// decoded again with the firmware's decoder (jog_asset_unpack.cpp): fontc
+// fails if one does not give back the bytes it was made from.
+//
+// height is a multiple of 8. Every code from first to last needs a glyph,
+// unless the font starts with a stretch line: that one takes every glyph of
+// an earlier 8 pixel high font, puts the blank column ss_oled draws in front
+// of it, and doubles it to twice the width and height (optionally smoothing
+// the diagonals the way ss_oled used to at run time). Glyphs that follow
+// replace the stretched ones.
+//
+// Built and run by CMakeLists.txt, this is host code.
+//
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "jog_asset.h"
+
+struct Font {
+    std::string name;
+    int w, h, first, last;
+    bool packed;
+    bool bitmap; // one image, glyphs[0]
+    std::vector<std::vector<uint8_t>> glyphs; // w * h pixels each, row by row, empty = missing
+};
+
+static std::vector<Font> fonts;
+static const char *pFile;
+static int iLine;
+
+static void fail(const char *msg)
+{
+    fprintf(stderr, "%s:%d: %s\n", pFile, iLine, msg);
+    exit(1);
+}
+
+static Font *find_font(const char *name)
+{
+    for (auto &f : fonts)
+        if (f.name == name)
+            return &f;
+    return NULL;
+}
+
+// Glyph as column bytes in page order, the layout ss_oled draws from
+static std::vector<uint8_t> glyph_bytes(const Font &f, const std::vector<uint8_t> &px)
+{
+    std::vector<uint8_t> out(f.w * f.h / 8, 0);
+
+    for (int y = 0; y < f.h; y++)
+        for (int x = 0; x < f.w; x++)
+            if (px[y * f.w + x])
+                out[(y / 8) * f.w + x] |= 1 << (y & 7);
+    return out;
+}
+
+// Double an 8 pixel high glyph with the blank column in front, ucTemp[0..n)
+// holds its columns. This is what oledWriteString() used to do for every
+// FONT_12x16 and FONT_16x16 character.
+static std::vector<uint8_t> stretch_glyph(const uint8_t *ucTemp, int n, bool bSmooth)
+{
+    std::vector<uint8_t> out(4 * n, 0); // top page 2n columns, then the bottom one
+    uint8_t *pTop = &out[0], *pBottom = &out[2 * n];
+
+    for (int tx = 0; tx < n; tx++)
+    {
+        uint8_t uc1 = 0, uc2 = 0, ucMask = 3, c = ucTemp[tx];
+        for (int ty = 0; ty < 4; ty++)
+        {
+            if (c & (1 << ty))
+                uc1 |= ucMask;
+            if (c & (1 << (ty + 4)))
+                uc2 |= ucMask;
+            ucMask <<= 2;
+        }
+        pTop[tx * 2] = pTop[tx * 2 + 1] = uc1;
+        pBottom[tx * 2] = pBottom[tx * 2 + 1] = uc2;
+    }
+    if (!bSmooth)
+        return out;
+    for (int tx = 0; tx < n - 1; tx++)
+    {
+        uint8_t c0 = ucTemp[tx], c1 = ucTemp[tx + 1], ucMask = 1, ucMask2 = 2;
+        uint8_t *pT = &pTop[tx * 2], *pB = &pBottom[tx * 2];
+        for (int ty = 0; ty < 7; ty++)
+        {
+            if (((c0 & ucMask) && !(c1 & ucMask) && !(c0 & ucMask2) && (c1 & ucMask2)) ||
+                (!(c0 & ucMask) && (c1 & ucMask) && (c0 & ucMask2) && !(c1 & ucMask2)))
+            {
+                if (ty < 3) // top half
+                {
+                    pT[1] |= (1 << ((ty * 2) + 1));
+                    pT[2] |= (1 << ((ty * 2) + 1));
+                    pT[1] |= (1 << ((ty + 1) * 2));
+                    pT[2] |= (1 << ((ty + 1) * 2));
+                }
+                else if (ty == 3) // on the border
+                {
+                    pT[1] |= 0x80; pT[2] |= 0x80;
+                    pB[1] |= 1; pB[2] |= 1;
+                }
+                else // bottom half
+                {
+                    pB[1] |= (1 << (2 * (ty - 4) + 1));
+                    pB[2] |= (1 << (2 * (ty - 4) + 1));
+                    pB[1] |= (1 << ((ty - 3) * 2));
+                    pB[2] |= (1 << ((ty - 3) * 2));
+                }
+            }
+            ucMask <<= 1; ucMask2 <<= 1;
+        }
+    }
+    return out;
+}
+
+static void stretch_font(Font &f, const char *src, bool bSmooth)
+{
+    Font *s = find_font(src);
+    uint8_t ucTemp[32];
+
+    if (!s)
+        fail("stretch of an unknown font");
+    if (s->h != 8 || f.w != 2 * (s->w + 1) || f.h != 16 || s->first > f.first || s->last < f.last)
+        fail("stretch needs an 8 pixel high font, one blank column plus twice its size");
+    for (int c = f.first; c <= f.last; c++)
+    {
+        std::vector<uint8_t> col = glyph_bytes(*s, s->glyphs[c - s->first]);
+        ucTemp[0] = 0;
+        memcpy(&ucTemp[1], col.data(), s->w);
+        std::vector<uint8_t> bytes = stretch_glyph(ucTemp, s->w + 1, bSmooth);
+        std::vector<uint8_t> &px = f.glyphs[c - f.first];
+        px.assign(f.w * f.h, 0);
+        for (int y = 0; y < f.h; y++)
+            for (int x = 0; x < f.w; x++)
+                px[y * f.w + x] = (bytes[(y / 8) * f.w + x] >> (y & 7)) & 1;
+    }
+}
+
+// Opcodes of jog_asset.h, the run-length scheme of oledPlayAnimFrame()
+// with a skip writing blank bytes
+#define OP_SKIPCOPY 0x00
+#define OP_COPYSKIP 0x40
+#define OP_REPEATSKIP 0x80
+#define OP_REPEAT 0xc0
+
+// Length of the run of byte b at in[i], at most max
+static int run_length(const std::vector<uint8_t> &in, size_t i, uint8_t b, int max)
+{
+    int n = 0;
+
+    while (i + n < in.size() && in[i + n] == b && n < max)
+        n++;
+    return n;
+}
+
+// Literal bytes from in[i] up to the next blank byte or a repeat worth
+// coding, at most max
+static int literal_length(const std::vector<uint8_t> &in, size_t i, int max)
+{
+    int n = 0;
+
+    while (i + n < in.size() && n < max && in[i + n] != 0 && run_length(in, i + n, in[i + n], 3) < 3)
+        n++;
+    return n;
+}
+
+static std::vector<uint8_t> pack_bytes(const std::vector<uint8_t> &in)
+{
+    std::vector<uint8_t> out;
+    size_t i = 0;
+
+    while (i < in.size())
+    {
+        int zeros = run_length(in, i, 0, 256);
+        if (zeros > 7) // big skip
+        {
+            out.push_back(OP_SKIPCOPY);
+            out.push_back(zeros - 1);
+            i += zeros;
+        }
+        else if (zeros) // skip, then up to 7 literals
+        {
+            int copy = literal_length(in, i + zeros, 7);
+            out.push_back(OP_SKIPCOPY | (zeros << 3) | copy);
+            out.insert(out.end(), in.begin() + i + zeros, in.begin() + i + zeros + copy);
+            i += zeros + copy;
+        }
+        else if (run_length(in, i, in[i], 3) == 3) // repeat, then up to 7 blanks
+        {
+            int rep = run_length(in, i, in[i], 64);
+            if (rep <= 7)
+            {
+                int skip = run_length(in, i + rep, 0, 7);
+                out.push_back(OP_REPEATSKIP | (rep << 3) | skip);
+                out.push_back(in[i]);
+                i += rep + skip;
+            }
+            else
+            {
+                out.push_back(OP_REPEAT | (rep - 1));
+                out.push_back(in[i]);
+                i += rep;
+            }
+        }
+        else
+        {
+            int copy = literal_length(in, i, 256);
+            if (copy <= 7) // copy, then up to 7 blanks
+            {
+                int skip = run_length(in, i + copy, 0, 7);
+                out.push_back(OP_COPYSKIP | (copy << 3) | skip);
+                out.insert(out.end(), in.begin() + i, in.begin() + i + copy);
+                i += copy + skip;
+            }
+            else // big copy
+            {
+                out.push_back(OP_COPYSKIP);
+                out.push_back(copy - 1);
+                out.insert(out.end(), in.begin() + i, in.begin() + i + copy);
+                i += copy;
+            }
+        }
+    }
+    return out;
+}
+
+// The stream for one glyph or bitmap: the opcodes, or the bytes themselves
+// when the opcodes are not smaller, checked by decoding it back
+static std::vector<uint8_t> pack_asset(const Font &f, int code, const std::vector<uint8_t> &in)
+{
+    std::vector<uint8_t> ops = pack_bytes(in);
+    std::vector<uint8_t> back(in.size(), 0xa5); // a byte the decoder misses shows up
+
+    if (ops.size() >= in.size())
+        ops = in;
+    asset_unpack(ops.data(), (int)ops.size(), f.w, f.h / 8, back.data(), f.w, f.w, f.h / 8, 0);
+    if (back != in)
+    {
+        fprintf(stderr, "%s: glyph 0x%02x does not decode back to what was packed\n", f.name.c_str(), code);
+        exit(1);
+    }
+    return ops;
+}
+
+static void write_bytes(FILE *out, const std::vector<uint8_t> &b)
+{
+    for (size_t i = 0; i < b.size(); i++)
+        fprintf(out, "%s0x%02x,%s", (i & 15) ? "" : "  ", b[i], ((i & 15) == 15 || i == b.size() - 1) ? "\n" : "");
+}
+
+static void read_font_file(const char *path)
+{
+    char line[256];
+    Font *f = NULL;
+    int code = -1, row = 0;
+    char opt[16];
+    FILE *in = fopen(path, "r");
+
+    pFile = path;
+    iLine = 0;
+    if (!in)
+        fail("can't open");
+    while (fgets(line, sizeof(line), in))
+    {
+        iLine++;
+        line[strcspn(line, "\r\n")] = 0;
+        if (code >= 0) // inside a glyph
+        {
+            if ((int)strlen(line) != f->w || strspn(line, "#.") != strlen(line))
+                fail("glyph row has the wrong width or characters");
+            for (int x = 0; x < f->w; x++)
+                f->glyphs[code - f->first][row * f->w + x] = line[x] == '#';
+            if (++row == f->h)
+                code = -1;
+            continue;
+        }
+        if (line[0] == '#' || line[0] == 0)
+            continue;
+        if (strncmp(line, "font ", 5) == 0)
+        {
+            char name[64];
+            Font nf;
+            opt[0] = 0;
+            if (sscanf(line, "font %63s %dx%d %d %d %15s", name, &nf.w, &nf.h, &nf.first, &nf.last, opt) < 5 ||
+                nf.w < 1 || nf.w > 32 || nf.h < 8 || (nf.h & 7) || nf.first > nf.last || (opt[0] && strcmp(opt, "packed")))
+                fail("bad font line");
+            if (find_font(name))
+                fail("font defined twice");
+            nf.name = name;
+            nf.packed = opt[0] != 0;
+            nf.bitmap = false;
+            nf.glyphs.resize(nf.last - nf.first + 1);
+            fonts.push_back(nf);
+            f = &fonts.back();
+        }
+        else if (strncmp(line, "bitmap ", 7) == 0)
+        {
+            char name[64];
+            Font nf;
+            if (sscanf(line, "bitmap %63s %dx%d", name, &nf.w, &nf.h) != 3 ||
+                nf.w < 1 || nf.w > 128 || nf.h < 8 || nf.h > 64 || (nf.h & 7))
+                fail("bad bitmap line");
+            if (find_font(name))
+                fail("bitmap defined twice");
+            nf.name = name;
+            nf.first = nf.last = 0;
+            nf.packed = nf.bitmap = true;
+            nf.glyphs.resize(1);
+            fonts.push_back(nf);
+            f = &fonts.back();
+            code = 0; // the rows follow
+            f->glyphs[0].assign(f->w * f->h, 0);
+            row = 0;
+        }
+        else if (f && !f->bitmap && strncmp(line, "stretch ", 8) == 0)
+        {
+            char src[64], opt[16] = "";
+            if (sscanf(line, "stretch %63s %15s", src, opt) < 1)
+                fail("bad stretch line");
+            stretch_font(*f, src, strcmp(opt, "smooth") == 0);
+        }
+        else if (f && !f->bitmap && line[0] == ':')
+        {
+            code = (int)strtol(&line[1], NULL, 0);
+            if (code < f->first || code > f->last)
+                fail("glyph code outside the font");
+            f->glyphs[code - f->first].assign(f->w * f->h, 0);
+            row = 0;
+        }
+        else
+            fail("expected font, bitmap, stretch or a glyph");
+    }
+    if (code >= 0)
+        fail("file ends inside a glyph");
+    fclose(in);
+}
+
+// Include guard from the output file name, ss_oled_fonts.h -> __SS_OLED_FONTS_H__
+static std::string guard_name(const char *path)
+{
+    const char *base = strrchr(path, '/');
+    std::string g = "__";
+
+    for (const char *p = base ? base + 1 : path; *p; p++)
+        g += isalnum((unsigned char)*p) ? (char)toupper((unsigned char)*p) : '_';
+    return g + "__";
+}
+
+int main(int argc, char **argv)
+{
+    FILE *out;
+    std::string guard;
+    bool bPacked = false;
+
+    if (argc < 3)
+    {
+        fprintf(stderr, "usage: fontc <output.h> <font.txt>...\n");
+        return 1;
+    }
+    for (int i = 2; i < argc; i++)
+        read_font_file(argv[i]);
+    for (auto &f : fonts)
+    {
+        bPacked |= f.packed;
+        for (int c = f.first; c <= f.last; c++)
+        {
+            if (f.glyphs[c - f.first].empty())
+            {
+                fprintf(stderr, "%s: glyph 0x%02x is missing\n", f.name.c_str(), c);
+                return 1;
+            }
+        }
+    }
+
+    out = fopen(argv[1], "w");
+    if (!out)
+    {
+        fprintf(stderr, "can't write %s\n", argv[1]);
+        return 1;
+    }
+    guard = guard_name(argv[1]);
+    fprintf(out, "// Generated by tools/fontc.cpp, do not edit\n");
+    fprintf(out, "#ifndef %s\n#define %s\n\n#include <stdint.h>\n", guard.c_str(), guard.c_str());
+    if (bPacked)
+        fprintf(out, "#include \"jog_asset.h\"\n");
+    for (auto &f : fonts)
+    {
+        int bytes = f.w * f.h / 8;
+        if (f.bitmap)
+        {
+            std::vector<uint8_t> ops = pack_asset(f, 0, glyph_bytes(f, f.glyphs[0]));
+            if ((int)ops.size() == bytes)
+                fprintf(out, "\n// %dx%d bitmap, stored raw, %d bytes\n", f.w, f.h, bytes);
+            else
+                fprintf(out, "\n// %dx%d bitmap, packed to %d of %d bytes\n", f.w, f.h, (int)ops.size(), bytes);
+            fprintf(out, "constexpr uint8_t %s_ops[] = {\n", f.name.c_str());
+            write_bytes(out, ops);
+            fprintf(out, "};\n");
+            fprintf(out, "constexpr asset_bitmap_t %s = {%s_ops, %d, %d, %d};\n", f.name.c_str(), f.name.c_str(),
+                    (int)ops.size(), f.w, f.h / 8);
+        }
+        else if (f.packed)
+        {
+            std::vector<uint8_t> ops;
+            std::vector<int> index;
+            for (int c = f.first; c <= f.last; c++)
+            {
+                std::vector<uint8_t> g = pack_asset(f, c, glyph_bytes(f, f.glyphs[c - f.first]));
+                index.push_back(ops.size());
+                ops.insert(ops.end(), g.begin(), g.end());
+            }
+            index.push_back(ops.size());
+            if (ops.size() > 65535)
+            {
+                fprintf(stderr, "%s: too big to pack\n", f.name.c_str());
+                return 1;
+            }
+            fprintf(out, "\n// %dx%d, codes %d-%d, %d bytes per glyph, packed to %d of %d bytes\n", f.w, f.h, f.first,
+                    f.last, bytes, (int)(ops.size() + 2 * index.size()), bytes * (f.last - f.first + 1));
+            fprintf(out, "constexpr uint8_t %s_ops[] = {\n", f.name.c_str());
+            write_bytes(out, ops);
+            fprintf(out, "};\nconstexpr uint16_t %s_index[] = {\n", f.name.c_str()); // where each glyph starts, then the end
+            for (size_t i = 0; i < index.size(); i++)
+                fprintf(out, "%s%d,%s", (i & 15) ? " " : "  ", index[i], ((i & 15) == 15 || i == index.size() - 1) ? "\n" : "");
+            fprintf(out, "};\n");
+            fprintf(out, "constexpr asset_font_t %s = {%s_ops, %s_index, %d, %d, %d, %d};\n", f.name.c_str(),
+                    f.name.c_str(), f.name.c_str(), f.w, f.h / 8, f.first, f.last);
+        }
+        else
+        {
+            fprintf(out, "\n// %dx%d, codes %d-%d, %d bytes per glyph\n", f.w, f.h, f.first, f.last, bytes);
+            fprintf(out, "constexpr uint8_t %s[] = {\n", f.name.c_str());
+            for (int c = f.first; c <= f.last; c++)
+                write_bytes(out, glyph_bytes(f, f.glyphs[c - f.first]));
+            fprintf(out, "};\n");
+        }
+    }
+    fprintf(out, "\n#endif // %s\n", guard.c_str());
+    fclose(out);
+    return 0;
+}